@@ -72,6 +72,14 @@ def _get_cache_opts(level, options):
     if hasattr(options, prefetcher_attr):
         opts["prefetcher"] = _get_hwp(getattr(options, prefetcher_attr))
 
+    if getattr(options, f"{level}_refresh_enabled", 0):
+        opts["refresh_period"] = getattr(options, f"{level}_refresh_period")
+        opts["refresh_latency"] = getattr(options, f"{level}_refresh_latency")
+        opts["refresh_banks"] = getattr(options, f"{level}_refresh_banks")
+        opts["refresh_schedule"] = getattr(
+            options, f"{level}_refresh_schedule"
+        )
+
     return opts
 
 
@@ -195,6 +195,24 @@ def addNoISAOptions(parser):
     parser.add_argument("--l1d_assoc", type=int, default=2)
     parser.add_argument("--l1i_assoc", type=int, default=2)
     parser.add_argument("--l2_assoc", type=int, default=8)
+    # L2 refresh, for both the classic and the Ruby (MERSI_Three_Level) L2
+    parser.add_argument("--l2_refresh_period", type=int, default=90)
+    parser.add_argument("--l2_refresh_latency", type=int, default=10)
+    parser.add_argument("--l2_refresh_enabled", type=int, default=0)
+    parser.add_argument(
+        "--l2_refresh_schedule",
+        type=str,
+        default="",
+        help="NS-Cache refresh schedule file with per-bank refresh offsets",
+    )
+    parser.add_argument(
+        "--l2_refresh_banks",
+        type=int,
+        default=1,
+        help="banks of the classic L2 refreshed in their own windows, "
+        "unless --l2_refresh_schedule gives them; Ruby uses "
+        "--num_data_banks",
+    )
     parser.add_argument("--l3_assoc", type=int, default=16)
     parser.add_argument("--cacheline_size", type=int, default=64)
 
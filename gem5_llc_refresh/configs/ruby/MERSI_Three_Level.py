@@ -74,9 +74,103 @@ def define_options(parser):
     parser.add_argument("--l2_data_miss_latency", type=int, default=2)
     parser.add_argument("--l2_data_hit_latency", type=int, default=4)
     parser.add_argument("--l2_data_write_latency", type=int, default=4)
-    parser.add_argument("--l2_refresh_period", type=int, default=90)
-    parser.add_argument("--l2_refresh_latency", type=int, default=10)
-    parser.add_argument("--l2_refresh_enabled", type=int, default=0)
+    parser.add_argument(
+        "--l2_refresh_postpone",
+        type=int,
+        default=0,
+        help="L2 refreshes a bank with demand may postpone (elastic refresh)",
+    )
+    parser.add_argument(
+        "--l2_refresh_pull_in",
+        type=int,
+        default=0,
+        help="L2 refreshes an idle bank may issue early (elastic refresh)",
+    )
+    parser.add_argument(
+        "--l2_refresh_idle",
+        type=int,
+        default=16,
+        help="cycles without demand before an L2 bank counts as idle",
+    )
+    parser.add_argument(
+        "--l2_retention_cycles",
+        type=int,
+        default=0,
+        help="L2 cell retention time; elastic refresh keeps every row "
+        "within it",
+    )
+    parser.add_argument(
+        "--l2_refresh_rows",
+        type=int,
+        default=1,
+        help="refreshes that cover every row of an L2 bank once",
+    )
+    parser.add_argument(
+        "--l2_refresh_energy",
+        type=float,
+        default=0.0,
+        help="energy (J) to refresh one row of every bank of the whole L2 "
+        "data array, for the refresh energy stat",
+    )
+    parser.add_argument(
+        "--l2_refresh_skip_invalid",
+        action="store_true",
+        default=False,
+        help="skip the refresh of L2 rows without valid lines",
+    )
+    parser.add_argument(
+        "--l2_refresh_distributed",
+        action="store_true",
+        default=False,
+        help="an L2 refresh only blocks the sets of the row it refreshes "
+        "instead of the whole bank",
+    )
+    parser.add_argument(
+        "--l2_retention_bins",
+        type=str,
+        default="",
+        help="comma-separated refresh period multiples of the L2 retention "
+        "bins, shortest first, for multi-rate refresh (e.g. 1,2,4)",
+    )
+    parser.add_argument(
+        "--l2_retention_fractions",
+        type=str,
+        default="",
+        help="comma-separated fraction of L2 rows in each bin but the last",
+    )
+    parser.add_argument(
+        "--l2_retention_profile",
+        type=str,
+        default="",
+        help="per-row L2 retention profile; overrides the fractions",
+    )
+    parser.add_argument(
+        "--l2_retention_bloom_size",
+        type=int,
+        default=4096,
+        help="entries of the bloom filter of each L2 retention bin",
+    )
+    parser.add_argument(
+        "--l2_dead_block_decay",
+        type=int,
+        default=0,
+        help="cycles without an access after which an L2 line is predicted "
+        "dead and its row may expire instead of being refreshed; 0 disables",
+    )
+    parser.add_argument(
+        "--l2_dead_block_max_decay",
+        type=int,
+        default=0,
+        help="longest decay the L2 dead-block predictor adapts to on "
+        "mispredictions; 0 keeps the decay fixed",
+    )
+    parser.add_argument(
+        "--l2_nuca_latency",
+        type=str,
+        default="",
+        help="NS-Cache per-slice latency file; overrides the L2 hit, miss, "
+        "and write latencies of each slice of a cluster",
+    )
     parser.add_argument("--tag_read_latency", type=int, default=2)
     parser.add_argument("--data_read_latency", type=int, default=4)
     parser.add_argument("--tag_write_latency", type=int, default=4)
@@ -90,6 +184,21 @@ def define_options(parser):
     parser.add_argument("--l2_serial_parallel_mode", type=int, default=0)
     parser.add_argument("--serial_latency", type=int, default=0)
     parser.add_argument("--parallel_penalty", type=int, default=0)
+    parser.add_argument(
+        "--l2_data_issue_latency",
+        type=int,
+        default=0,
+        help="Cycles a read holds an L2 data bank when the array is "
+        "pipelined (NS-Cache initiation interval); 0 holds it for "
+        "--data_read_latency",
+    )
+    parser.add_argument(
+        "--l2_tag_issue_latency",
+        type=int,
+        default=0,
+        help="Cycles a read holds an L2 tag bank when the array is "
+        "pipelined; 0 holds it for --tag_read_latency",
+    )
 
     parser.add_argument(
         "--enable-prefetch",
@@ -100,6 +209,47 @@ def define_options(parser):
     return
 
 
+def read_nuca_latency(path):
+    """(hit, miss, write) cycles of each slice in an NS-Cache NUCA table"""
+    latencies = []
+    with open(path) as table:
+        for line in table:
+            fields = line.split()
+            if not fields or fields[0].startswith("#"):
+                continue
+            latencies.append(tuple(int(float(f)) for f in fields[3:6]))
+    return latencies
+
+
+def refresh_controller(options, period, latency, energy=0.0):
+    """Refresh of one L2 array, elastic if postponing or pulling in"""
+    controller = RubyRefreshController(
+        period=period,
+        latency=latency,
+        energy_per_refresh=energy,
+        max_postponed=options.l2_refresh_postpone,
+        max_pulled_in=options.l2_refresh_pull_in,
+        idle_threshold=options.l2_refresh_idle,
+        retention_time=options.l2_retention_cycles,
+        rows=options.l2_refresh_rows,
+        skip_invalid=options.l2_refresh_skip_invalid,
+        distributed=options.l2_refresh_distributed,
+    )
+    multipliers = [int(m) for m in options.l2_retention_bins.split(",") if m]
+    if len(multipliers) > 1:
+        # The filters are keyed by row, not by address
+        controller.retention_bins = [
+            BloomFilterH3(size=options.l2_retention_bloom_size, offset_bits=0)
+            for _ in multipliers[:-1]
+        ]
+        controller.bin_multipliers = multipliers
+        controller.bin_fractions = [
+            float(f) for f in options.l2_retention_fractions.split(",") if f
+        ]
+        controller.retention_profile = options.l2_retention_profile
+    return controller
+
+
 def create_system(
     options, full_system, system, dma_ports, bootmem, ruby_system, cpus
 ):
@@ -132,6 +282,26 @@ def create_system(
     block_size_bits = int(math.log(options.cacheline_size, 2))
     l2_index_start = block_size_bits + l2_bits
 
+    # Uniform L2 latency unless NS-Cache gave every slice its own
+    l2_latencies = [
+        (
+            options.l2_data_hit_latency,
+            options.l2_data_miss_latency,
+            options.l2_data_write_latency,
+        )
+    ] * num_l2caches_per_cluster
+    if options.l2_nuca_latency:
+        l2_latencies = read_nuca_latency(options.l2_nuca_latency)
+        if len(l2_latencies) != num_l2caches_per_cluster:
+            fatal(
+                "%s has %d slices, but there are %d L2 caches per cluster"
+                % (
+                    options.l2_nuca_latency,
+                    len(l2_latencies),
+                    num_l2caches_per_cluster,
+                )
+            )
+
     #
     # Must create the individual controllers before the network to ensure the
     # controller constructors are called before the network constructor
@@ -251,7 +421,29 @@ def create_system(
                 resourceStalls=True,
                 dataArrayBanks=options.num_data_banks,
                 tagArrayBanks=options.num_tag_banks,
+                refresh_schedule=options.l2_refresh_schedule,
             )
+            # Each bank refreshes for the latency at the end of every period
+            if options.l2_refresh_enabled:
+                # The energy is split over every bank of every slice
+                l2_cache.data_refresh = refresh_controller(
+                    options,
+                    options.l2_refresh_period,
+                    options.l2_refresh_latency,
+                    options.l2_refresh_energy
+                    / (options.num_l2caches * options.num_data_banks),
+                )
+                if options.l2_dead_block_decay > 0:
+                    l2_cache.dead_block_predictor = RubyDeadBlockPredictor(
+                        decay=options.l2_dead_block_decay,
+                        max_decay=options.l2_dead_block_max_decay,
+                    )
+            if options.l2_tag_refresh_enabled:
+                l2_cache.tag_refresh = refresh_controller(
+                    options,
+                    options.l2_tag_refresh_period,
+                    options.l2_tag_refresh_latency,
+                )
 
             l2_cntrl = L2Cache_Controller(
                 version=i * num_l2caches_per_cluster + j,
@@ -259,28 +451,20 @@ def create_system(
                 cluster_id=i,
                 transitions_per_cycle=options.l2_transitions_per_cycle,
                 ruby_system=ruby_system,
-                l2_data_miss_latency=options.l2_data_miss_latency,
-                l2_data_hit_latency=options.l2_data_hit_latency,
-                l2_data_write_latency=options.l2_data_write_latency,
-                l2_refresh_period=options.l2_refresh_period
-                - options.l2_refresh_latency,
-                l2_refresh_latency=options.l2_refresh_latency,
-                l2_refresh_enabled=options.l2_refresh_enabled,
-                l2_refresh_total=options.l2_refresh_period,
+                l2_data_miss_latency=l2_latencies[j][1],
+                l2_data_hit_latency=l2_latencies[j][0],
+                l2_data_write_latency=l2_latencies[j][2],
                 tag_read_latency=options.tag_read_latency,
                 data_read_latency=options.data_read_latency,
                 tag_write_latency=options.tag_write_latency,
                 data_write_latency=options.data_write_latency,
-                l2_tag_refresh_period=options.l2_tag_refresh_period
-                - options.l2_tag_refresh_latency,
-                l2_tag_refresh_latency=options.l2_tag_refresh_latency,
-                l2_tag_refresh_enabled=options.l2_tag_refresh_enabled,
-                l2_tag_refresh_total=options.l2_tag_refresh_period,
                 num_data_banks=options.num_data_banks,
                 num_tag_banks=options.num_tag_banks,
                 l2_serial_parallel_mode=options.l2_serial_parallel_mode,
                 serial_latency=options.serial_latency,
                 parallel_penalty=options.parallel_penalty,
+                l2_data_issue_latency=options.l2_data_issue_latency,
+                l2_tag_issue_latency=options.l2_tag_issue_latency,
             )
 
             exec(
@@ -307,6 +491,9 @@ def create_system(
             l2_cntrl.L1RequestToL2Cache.in_port = ruby_system.network.out_port
             l2_cntrl.responseToL2Cache = MessageBuffer()
             l2_cntrl.responseToL2Cache.in_port = ruby_system.network.out_port
+            # Lines whose rows expire are replaced from this queue
+            l2_cntrl.expiredLineQueue = MessageBuffer()
+            l2_cache.expired_line_queue = l2_cntrl.expiredLineQueue
 
     # Run each of the ruby memory controllers at a ratio of the frequency of
     # the ruby system
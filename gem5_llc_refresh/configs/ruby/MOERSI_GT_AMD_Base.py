@@ -154,6 +154,11 @@ class L3Cache(RubyCache):
         self.tagAccessLatency = options.l3_tag_latency
         self.resourceStalls = options.no_resource_stalls
         self.replacement_policy = TreePLRURP()
+        if options.l3_refresh_latency > 0:
+            self.data_refresh = RubyRefreshController(
+                period=options.l3_refresh_period,
+                latency=options.l3_refresh_latency,
+            )
 
 
 class L3Cntrl(L3Cache_Controller, CntrlBase):
@@ -161,9 +166,6 @@ class L3Cntrl(L3Cache_Controller, CntrlBase):
         self.version = self.versionCount()
         self.L3cache = L3Cache()
         self.L3cache.create(options, ruby_system, system)
-        self.l3_refresh_period = 80
-        self.l3_refresh_latency = 20
-        self.l3_refresh_total = 100
 
         self.l3_response_latency = max(
             self.L3cache.dataAccessLatency, self.L3cache.tagAccessLatency
@@ -197,10 +199,6 @@ class DirCntrl(Directory_Controller, CntrlBase):
         self.L2isWB = False
         self.response_latency = 30
 
-        self.l3_refresh_period = 80
-        self.l3_refresh_latency = 20
-        self.l3_refresh_total = 100
-
         self.addr_ranges = dir_ranges
         self.directory = RubyDirectoryMemory()
 
@@ -243,6 +241,14 @@ def define_options(parser):
     parser.add_argument("--l3-data-latency", type=int, default=20)
     parser.add_argument("--l3-tag-latency", type=int, default=15)
     parser.add_argument("--cpu-to-dir-latency", type=int, default=15)
+    parser.add_argument("--l3-refresh-period", type=int, default=100)
+    parser.add_argument(
+        "--l3-refresh-latency",
+        type=int,
+        default=20,
+        help="Cycles each L3 data bank refreshes at the end of every "
+        "period; 0 disables L3 refresh",
+    )
     parser.add_argument(
         "--no-resource-stalls", action="store_false", default=True
     )
@@ -125,6 +125,23 @@ class BaseCache(ClockedObject):
         True, "Try to co-allocate blocks that contract"
     )
 
+    refresh_period = Param.Cycles(
+        0, "Cycles from one refresh of a bank to the next"
+    )
+    refresh_latency = Param.Cycles(
+        0,
+        "Cycles a bank is busy refreshing at the end of each refresh "
+        "period, 0 disables refresh",
+    )
+    refresh_banks = Param.Unsigned(
+        1, "Banks refreshed in their own windows, blocks are interleaved"
+    )
+    refresh_schedule = Param.String(
+        "",
+        "NS-Cache refresh schedule with the window offset of each bank, "
+        "overrides refresh_banks",
+    )
+
     sequential_access = Param.Bool(
         False, "Whether to access tags and data sequentially"
     )
@@ -45,6 +45,9 @@
 
 #include "mem/cache/base.hh"
 
+#include <fstream>
+#include <sstream>
+
 #include "base/compiler.hh"
 #include "base/logging.hh"
 #include "debug/Cache.hh"
@@ -100,6 +103,9 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       fillLatency(p.data_latency),
       responseLatency(p.response_latency),
       sequentialAccess(p.sequential_access),
+      refreshPeriod(p.refresh_period),
+      refreshLatency(p.refresh_latency),
+      refreshOffset(p.refresh_banks, Cycles(0)),
       numTarget(p.tgts_per_mshr),
       forwardSnoops(true),
       clusivity(p.clusivity),
@@ -136,6 +142,14 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
         "Compressed cache %s does not have a compression algorithm", name());
     if (compressor)
         compressor->setCache(this);
+
+    fatal_if(refreshLatency > refreshPeriod,
+        "Refresh latency %d of cache %s exceeds its refresh period %d",
+        refreshLatency, name(), refreshPeriod);
+    fatal_if(refreshOffset.empty(),
+        "Cache %s needs at least one refresh bank", name());
+    if (refreshLatency > 0 && !p.refresh_schedule.empty())
+        loadRefreshSchedule(p.refresh_schedule);
 }
 
 BaseCache::~BaseCache()
@@ -404,9 +418,15 @@ BaseCache::handleTimingReqMiss(PacketPtr pkt, MSHR *mshr, CacheBlk *blk,
 void
 BaseCache::recvTimingReq(PacketPtr pkt)
 {
+    // an access to a refreshing bank waits for the refresh to end before
+    // its lookup, whether it hits or is forwarded
+    const Cycles refresh_lat = pkt->req->isUncacheable() ? Cycles(0) :
+        refreshDelay(pkt->getAddr(), pkt->headerDelay);
+
     // anything that is merely forwarded pays for the forward latency and
     // the delay provided by the crossbar
-    Tick forward_time = clockEdge(forwardLatency) + pkt->headerDelay;
+    Tick forward_time = clockEdge(forwardLatency + refresh_lat) +
+        pkt->headerDelay;
 
     if (pkt->cmd == MemCmd::LockedRMWWriteReq) {
         // For LockedRMW accesses, we mark the block inaccessible after the
@@ -430,6 +450,7 @@ BaseCache::recvTimingReq(PacketPtr pkt)
         // Note that lat is passed by reference here. The function
         // access() will set the lat value.
         satisfied = access(pkt, blk, lat, writebacks);
+        lat += refresh_lat;
 
         // After the evicted blocks are selected, they must be forwarded
         // to the write buffer to ensure they logically precede anything
@@ -646,6 +667,8 @@ BaseCache::recvAtomic(PacketPtr pkt)
     CacheBlk *blk = nullptr;
     PacketList writebacks;
     bool satisfied = access(pkt, blk, lat, writebacks);
+    if (!pkt->req->isUncacheable())
+        lat += refreshDelay(pkt->getAddr(), pkt->headerDelay);
 
     if (pkt->isClean() && blk && blk->isSet(CacheBlk::DirtyBit)) {
         // A cache clean opearation is looking for a dirty
@@ -1201,6 +1224,63 @@ BaseCache::calculateTagOnlyLatency(const uint32_t delay,
     return ticksToCycles(delay) + lookup_lat;
 }
 
+Cycles
+BaseCache::refreshDelay(Addr addr, Tick delay)
+{
+    if (refreshLatency == 0)
+        return Cycles(0);
+
+    // The k-th refresh of a bank takes the last refreshLatency cycles
+    // of the k-th period after its offset
+    const Cycles offset =
+        refreshOffset[(addr / blkSize) % refreshOffset.size()];
+    const Cycles first = offset + refreshPeriod - refreshLatency;
+    const Cycles cycle = curCycle() + ticksToCycles(delay);
+    if (cycle < first)
+        return Cycles(0);
+    const uint64_t phase = (cycle - first) % refreshPeriod;
+    if (phase >= refreshLatency)
+        return Cycles(0);
+
+    const Cycles wait(refreshLatency - phase);
+    stats.refreshCollisions++;
+    stats.refreshStallCycles += wait;
+    DPRINTF(Cache, "%s: %#llx waits %d cycles for a refresh\n", __func__,
+            addr, wait);
+    return wait;
+}
+
+void
+BaseCache::loadRefreshSchedule(const std::string &file_name)
+{
+    std::ifstream file(file_name);
+    fatal_if(!file.is_open(), "Cannot open refresh schedule %s", file_name);
+
+    // Each non-comment line is "<data|tag> <bank> <offset> <duration>
+    // <period>" in cycles; the array refreshes as the data array does
+    std::vector<Cycles> offsets;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#')
+            continue;
+        std::istringstream fields(line);
+        std::string array;
+        unsigned int bank;
+        uint64_t offset, duration, period;
+        fatal_if(!(fields >> array >> bank >> offset >> duration >> period),
+            "Malformed line in refresh schedule %s: %s", file_name, line);
+        if (array != "data")
+            continue;
+        if (offsets.size() <= bank)
+            offsets.resize(bank + 1, Cycles(0));
+        offsets[bank] = Cycles(offset % refreshPeriod);
+    }
+
+    fatal_if(offsets.empty(), "Refresh schedule %s has no data banks",
+             file_name);
+    refreshOffset = offsets;
+}
+
 Cycles
 BaseCache::calculateAccessLatency(const CacheBlk* blk, const uint32_t delay,
                                   const Cycles lookup_lat) const
@@ -2278,6 +2358,10 @@ BaseCache::CacheStats::CacheStats(BaseCache &c)
              "average overall mshr uncacheable latency"),
     ADD_STAT(replacements, statistics::units::Count::get(),
              "number of replacements"),
+    ADD_STAT(refreshCollisions, statistics::units::Count::get(),
+             "number of accesses delayed by a refresh"),
+    ADD_STAT(refreshStallCycles, statistics::units::Cycle::get(),
+             "number of cycles accesses waited for a refresh"),
     ADD_STAT(dataExpansions, statistics::units::Count::get(),
              "number of data expansions"),
     ADD_STAT(dataContractions, statistics::units::Count::get(),
@@ -2511,6 +2595,8 @@ BaseCache::CacheStats::regStats()
 
     dataExpansions.flags(nozero | nonan);
     dataContractions.flags(nozero | nonan);
+    refreshCollisions.flags(nozero);
+    refreshStallCycles.flags(nozero);
 }
 
 void
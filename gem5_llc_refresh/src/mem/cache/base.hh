@@ -49,6 +49,7 @@
 #include <cassert>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "base/addr_range.hh"
 #include "base/compiler.hh"
@@ -479,6 +480,26 @@ class BaseCache : public ClockedObject
     Cycles calculateAccessLatency(const CacheBlk* blk, const uint32_t delay,
                                   const Cycles lookup_lat) const;
 
+    /**
+     * Calculate how long an access waits for the refresh of its bank.
+     *
+     * @param addr The address accessed, blocks are interleaved over the
+     *        refresh banks.
+     * @param delay The delay until the access reaches the array.
+     * @return The cycles until the refresh ends, 0 if the bank is not
+     *         refreshing.
+     */
+    Cycles refreshDelay(Addr addr, Tick delay);
+
+    /**
+     * Read the per-bank refresh offsets of the data array from an
+     * NS-Cache refresh schedule; the refresh banks are those of the
+     * schedule.
+     *
+     * @param file_name The schedule written by NS-Cache -RefreshSchedule.
+     */
+    void loadRefreshSchedule(const std::string &file_name);
+
     /**
      * Does all the processing necessary to perform the provided request.
      * @param pkt The memory request to perform.
@@ -920,6 +941,18 @@ class BaseCache : public ClockedObject
      */
     const bool sequentialAccess;
 
+    /**
+     * Refresh of the cache array, with the windows of the Ruby refresh
+     * controller without elastic refresh: each bank is busy refreshing
+     * for refreshLatency cycles at the end of every refreshPeriod,
+     * shifted by its offset. Accesses to a refreshing bank wait for the
+     * refresh to end. A refreshLatency of 0 disables refresh.
+     */
+    const Cycles refreshPeriod;
+    const Cycles refreshLatency;
+    /** Refresh window offset of each bank, one entry per bank. */
+    std::vector<Cycles> refreshOffset;
+
     /** The number of targets for each MSHR. */
     const int numTarget;
 
@@ -1132,6 +1165,11 @@ class BaseCache : public ClockedObject
         /** Number of replacements of valid blocks. */
         statistics::Scalar replacements;
 
+        /** Number of accesses that waited for a refresh. */
+        statistics::Scalar refreshCollisions;
+        /** Total cycles accesses waited for a refresh. */
+        statistics::Scalar refreshStallCycles;
+
         /** Number of data expansions. */
         statistics::Scalar dataExpansions;
 
@@ -110,11 +110,17 @@ class AbstractCacheEntry : public ReplaceableEntry
                                    // block, required by CacheMemory
 
     // Get the last access Tick.
-    Tick getLastAccess() { return m_last_touch_tick; }
+    Tick getLastAccess() const { return m_last_touch_tick; }
 
     // Set the last access Tick.
     void setLastAccess(Tick tick) { m_last_touch_tick = tick; }
 
+    // Whether a cache above this one holds a copy of the block. Set by
+    // protocols that track their sharers, so refresh knows which lines
+    // it may let expire.
+    bool isCachedAbove() const { return m_cached_above; }
+    void setCachedAbove(bool val) { m_cached_above = val; }
+
     // hardware transactional memory
     void setInHtmReadSet(bool val);
     void setInHtmWriteSet(bool val);
@@ -126,6 +132,8 @@ class AbstractCacheEntry : public ReplaceableEntry
     // hardware transactional memory
     bool m_htmInReadSet;
     bool m_htmInWriteSet;
+
+    bool m_cached_above;
 };
 
 inline std::ostream&
@@ -88,6 +88,26 @@ BankedArray::tryAccessSpecf(int64_t idx, Cycles cycle)
     return true;
 }
 
+Cycles
+BankedArray::freeCycle(int64_t idx)
+{
+    if (accessLatency == 0)
+        return Cycles(0);
+
+    unsigned int bank = mapIndexToBank(idx);
+    assert(bank < banks);
+
+    return Cycles(busyBanks[bank].endAccess / m_ruby_system->clockPeriod()
+                  + 1);
+}
+
+Cycles
+BankedArray::nextAvailableCycle(int64_t idx, Cycles cycle)
+{
+    Cycles free = freeCycle(idx);
+    return free > cycle ? free : cycle;
+}
+
 void
 BankedArray::reserve(int64_t idx)
 {
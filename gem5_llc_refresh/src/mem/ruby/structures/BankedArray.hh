@@ -73,6 +73,10 @@ class BankedArray
     // This is so we don't get aliasing on blocks being replaced
     bool tryAccess(int64_t idx);
     bool tryAccessSpecf(int64_t idx, Cycles cycle);
+    // The first cycle at which tryAccessSpecf succeeds on the bank
+    Cycles freeCycle(int64_t idx);
+    // The first cycle from the given one at which the bank is free
+    Cycles nextAvailableCycle(int64_t idx, Cycles cycle);
 
     void reserve(int64_t idx);
     void reserveSpecf(int64_t idx, Cycles access_time,
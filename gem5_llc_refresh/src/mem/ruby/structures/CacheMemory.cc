@@ -41,6 +41,9 @@
 
 #include "mem/ruby/structures/CacheMemory.hh"
 
+#include <fstream>
+#include <sstream>
+
 #include "base/compiler.hh"
 #include "base/intmath.hh"
 #include "base/logging.hh"
@@ -50,7 +53,9 @@
 #include "debug/RubyResourceStalls.hh"
 #include "debug/RubyStats.hh"
 #include "mem/cache/replacement_policies/weighted_lru_rp.hh"
+#include "mem/ruby/network/MessageBuffer.hh"
 #include "mem/ruby/protocol/AccessPermission.hh"
+#include "mem/ruby/slicc_interface/RubyRequest.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
 namespace gem5
@@ -75,6 +80,11 @@ CacheMemory::CacheMemory(const Params &p)
              p.start_index_bit, p.ruby_system),
     atomicALUArray(p.atomicALUs, p.atomicLatency *
              p.ruby_system->clockPeriod()),
+    m_data_refresh(p.data_refresh),
+    m_tag_refresh(p.tag_refresh),
+    m_dead_block(p.dead_block_predictor),
+    m_expired_queue(p.expired_line_queue),
+    m_ruby_system(p.ruby_system),
     cacheMemoryStats(this)
 {
     m_cache_size = p.size;
@@ -86,6 +96,8 @@ CacheMemory::CacheMemory(const Params &p)
     m_block_size = p.block_size;  // may be 0 at this point. Updated in init()
     m_use_occupancy = dynamic_cast<replacement_policy::WeightedLRU*>(
                                     m_replacementPolicy_ptr) ? true : false;
+    if (!p.refresh_schedule.empty())
+        loadRefreshSchedule(p.refresh_schedule);
 }
 
 void
@@ -110,6 +122,29 @@ CacheMemory::init()
                                 m_replacementPolicy_ptr->instantiateEntry();
         }
     }
+
+    if (m_data_refresh)
+        m_data_refresh->setBanks(dataArray.banks, m_cache_num_sets,
+                                 m_data_refresh_offset);
+    if (m_tag_refresh)
+        m_tag_refresh->setBanks(tagArray.banks, m_cache_num_sets,
+                                m_tag_refresh_offset);
+
+    // Only the data array lets rows expire, the tags stay refreshed so
+    // the expired lines remain known
+    if (m_dead_block) {
+        fatal_if(!m_data_refresh, "%s: a dead-block predictor needs a "
+                 "data array refresh controller\n", name());
+        fatal_if(!m_expired_queue, "%s: a dead-block predictor needs the "
+                 "expired line queue of the protocol\n", name());
+        m_expired.resize(m_cache_num_sets,
+                         std::vector<bool>(m_cache_assoc, false));
+        m_expired_shadow.resize(m_cache_num_sets,
+                                std::vector<Addr>(m_cache_assoc, MaxAddr));
+        m_data_refresh->setExpiryCheck(
+            [this](unsigned int bank, int64_t first, int64_t end)
+            { return keepRow(bank, first, end); });
+    }
 }
 
 CacheMemory::~CacheMemory()
@@ -298,6 +333,12 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
                     "leak here. Fix your protocol to eliminate these!",
                     address);
             }
+            if (!set[i])
+                noteValidLines(cacheSet, 1);
+            if (m_dead_block) {
+                m_expired[cacheSet][i] = false;
+                noteRefill(cacheSet, i, address);
+            }
             set[i] = entry;  // Init entry
             set[i]->m_Address = address;
             set[i]->m_Permission = AccessPermission_Invalid;
@@ -328,9 +369,18 @@ CacheMemory::deallocate(Addr address)
     m_replacementPolicy_ptr->invalidate(entry->replacementData);
     uint32_t cache_set = entry->getSet();
     uint32_t way = entry->getWay();
+    // The prediction of an expired line is resolved by what is allocated
+    // after it
+    if (m_dead_block && m_expired[cache_set][way]) {
+        m_expired[cache_set][way] = false;
+        if (m_expired_shadow[cache_set][way] != MaxAddr)
+            m_dead_block->noteEvicted();
+        m_expired_shadow[cache_set][way] = address;
+    }
     delete entry;
     m_cache[cache_set][way] = NULL;
     m_tag_index.erase(address);
+    noteValidLines(cache_set, -1);
 }
 
 // Returns with the physical address of the conflicting cache line
@@ -346,6 +396,24 @@ CacheMemory::cacheProbe(Addr address) const
         candidates.push_back(static_cast<ReplaceableEntry*>(
                                                        m_cache[cacheSet][i]));
     }
+
+    // Refresh-aware replacement: the policy picks among the lines whose
+    // data already expired, else among those predicted dead, whose rows
+    // are about to expire
+    if (m_dead_block) {
+        std::vector<ReplaceableEntry*> expired, dead;
+        for (int i = 0; i < m_cache_assoc; i++) {
+            AbstractCacheEntry *entry = m_cache[cacheSet][i];
+            if (m_expired[cacheSet][i])
+                expired.push_back(entry);
+            else if (m_dead_block->predictDead(idleCycles(entry)))
+                dead.push_back(entry);
+        }
+        if (!expired.empty())
+            candidates = expired;
+        else if (!dead.empty())
+            candidates = dead;
+    }
     return m_cache[cacheSet][m_replacementPolicy_ptr->
                         getVictim(candidates)->getWay()]->m_Address;
 }
@@ -378,6 +446,7 @@ CacheMemory::setMRU(Addr address)
 {
     AbstractCacheEntry* entry = lookup(makeLineAddress(address));
     if (entry != nullptr) {
+        noteLineAccess(entry);
         m_replacementPolicy_ptr->touch(entry->replacementData);
         entry->setLastAccess(curTick());
     }
@@ -387,6 +456,7 @@ void
 CacheMemory::setMRU(AbstractCacheEntry *entry)
 {
     assert(entry != nullptr);
+    noteLineAccess(entry);
     m_replacementPolicy_ptr->touch(entry->replacementData);
     entry->setLastAccess(curTick());
 }
@@ -396,6 +466,7 @@ CacheMemory::setMRU(Addr address, int occupancy)
 {
     AbstractCacheEntry* entry = lookup(makeLineAddress(address));
     if (entry != nullptr) {
+        noteLineAccess(entry);
         // m_use_occupancy can decide whether we are using WeightedLRU
         // replacement policy. Depending on different replacement policies,
         // use different touch() function.
@@ -544,6 +615,14 @@ CacheMemoryStats::CacheMemoryStats(statistics::Group *parent)
       ADD_STAT(numDataArrayStalls, "Number of stalls caused by data array"),
       ADD_STAT(numAtomicALUOperations, "Number of atomic ALU operations"),
       ADD_STAT(numAtomicALUArrayStalls, "Number of stalls caused by atomic ALU array"),
+      ADD_STAT(numDataArrayRefreshCollisions, "Number of data array "
+               "accesses delayed by a refresh"),
+      ADD_STAT(numTagArrayRefreshCollisions, "Number of tag array "
+               "accesses delayed by a refresh"),
+      ADD_STAT(dataArrayRefreshDelay, "Cycles data array accesses waited "
+               "for a refresh"),
+      ADD_STAT(tagArrayRefreshDelay, "Cycles tag array accesses waited "
+               "for a refresh"),
       ADD_STAT(htmTransCommitReadSet, "Read set size of a committed "
                                       "transaction"),
       ADD_STAT(htmTransCommitWriteSet, "Write set size of a committed "
@@ -585,6 +664,22 @@ CacheMemoryStats::CacheMemoryStats(statistics::Group *parent)
     numAtomicALUArrayStalls
         .flags(statistics::nozero);
 
+    numDataArrayRefreshCollisions
+        .flags(statistics::nozero);
+
+    numTagArrayRefreshCollisions
+        .flags(statistics::nozero);
+
+    dataArrayRefreshDelay
+        .init(16)
+        .flags(statistics::pdf | statistics::dist | statistics::nozero |
+            statistics::nonan);
+
+    tagArrayRefreshDelay
+        .init(16)
+        .flags(statistics::pdf | statistics::dist | statistics::nozero |
+            statistics::nonan);
+
     htmTransCommitReadSet
         .init(8)
         .flags(statistics::pdf | statistics::dist | statistics::nozero |
@@ -635,23 +730,39 @@ CacheMemory::recordRequestType(CacheRequestType requestType, Addr addr)
             CacheRequestType_to_string(requestType));
     switch(requestType) {
     case CacheRequestType_DataArrayRead:
+        noteRefreshCollision(CacheResourceType_DataArray, addr,
+                             m_ruby_system->curCycle());
         if (m_resource_stalls)
             dataArray.reserve(addressToCacheSet(addr));
+        noteRefreshDemand(CacheResourceType_DataArray, addr,
+                          m_ruby_system->curCycle() + getDataLatency());
         cacheMemoryStats.numDataArrayReads++;
         return;
     case CacheRequestType_DataArrayWrite:
+        noteRefreshCollision(CacheResourceType_DataArray, addr,
+                             m_ruby_system->curCycle());
         if (m_resource_stalls)
             dataArray.reserve(addressToCacheSet(addr));
+        noteRefreshDemand(CacheResourceType_DataArray, addr,
+                          m_ruby_system->curCycle() + getDataLatency());
         cacheMemoryStats.numDataArrayWrites++;
         return;
     case CacheRequestType_TagArrayRead:
+        noteRefreshCollision(CacheResourceType_TagArray, addr,
+                             m_ruby_system->curCycle());
         if (m_resource_stalls)
             tagArray.reserve(addressToCacheSet(addr));
+        noteRefreshDemand(CacheResourceType_TagArray, addr,
+                          m_ruby_system->curCycle() + getTagLatency());
         cacheMemoryStats.numTagArrayReads++;
         return;
     case CacheRequestType_TagArrayWrite:
+        noteRefreshCollision(CacheResourceType_TagArray, addr,
+                             m_ruby_system->curCycle());
         if (m_resource_stalls)
             tagArray.reserve(addressToCacheSet(addr));
+        noteRefreshDemand(CacheResourceType_TagArray, addr,
+                          m_ruby_system->curCycle() + getTagLatency());
         cacheMemoryStats.numTagArrayWrites++;
         return;
     case CacheRequestType_AtomicALUOperation:
@@ -673,19 +784,31 @@ CacheMemory::recordRequestTypeSpecf(CacheRequestType requestType, Addr addr,
             CacheRequestType_to_string(requestType));
     switch(requestType) {
     case CacheRequestType_DataArrayRead:
+        noteRefreshCollision(CacheResourceType_DataArray, addr, init_cycle);
         dataArray.reserveSpecf(addressToCacheSet(addr), access_time, init_cycle);
+        noteRefreshDemand(CacheResourceType_DataArray, addr,
+                          init_cycle + access_time);
         cacheMemoryStats.numDataArrayReads++;
         return;
     case CacheRequestType_DataArrayWrite:
+        noteRefreshCollision(CacheResourceType_DataArray, addr, init_cycle);
         dataArray.reserveSpecf(addressToCacheSet(addr), access_time, init_cycle);
+        noteRefreshDemand(CacheResourceType_DataArray, addr,
+                          init_cycle + access_time);
         cacheMemoryStats.numDataArrayWrites++;
         return;
     case CacheRequestType_TagArrayRead:
+        noteRefreshCollision(CacheResourceType_TagArray, addr, init_cycle);
         tagArray.reserveSpecf(addressToCacheSet(addr), access_time, init_cycle);
+        noteRefreshDemand(CacheResourceType_TagArray, addr,
+                          init_cycle + access_time);
         cacheMemoryStats.numTagArrayReads++;
         return;
     case CacheRequestType_TagArrayWrite:
+        noteRefreshCollision(CacheResourceType_TagArray, addr, init_cycle);
         tagArray.reserveSpecf(addressToCacheSet(addr), access_time, init_cycle);
+        noteRefreshDemand(CacheResourceType_TagArray, addr,
+                          init_cycle + access_time);
         cacheMemoryStats.numTagArrayWrites++;
         return;
     default:
@@ -776,27 +899,259 @@ CacheMemory::checkResourceAvailableSpecf(CacheResourceType res, Addr addr, Cycle
     }
 }
 
-int
-CacheMemory::getRefreshStartPoint(CacheResourceType res, Addr addr){
-
-    unsigned int bankIndex;
-
-    if(res == CacheResourceType_TagArray){
-        bankIndex = tagArray.mapIndexToBank(addressToCacheSet(addr));
-        //return (3000000000-252000)/tagArray.banks * bankIndex; /* Total Fill */
-        //return (252000) * bankIndex; /* Back 2 Back */
-       // return (252000/2) * bankIndex; /* Partial Overlap */
-    } else if (res == CacheResourceType_DataArray){
-        bankIndex = dataArray.mapIndexToBank(addressToCacheSet(addr));
-        //return (3000000000-252000)/dataArray.banks * bankIndex;
-        //return (252000) * bankIndex;
-        //return (252000/2) * bankIndex;
+RefreshController *
+CacheMemory::refreshBank(CacheResourceType res, Addr addr,
+                         unsigned int &bank, int64_t &set)
+{
+    if (res == CacheResourceType_TagArray) {
+        if (m_tag_refresh) {
+            set = addressToCacheSet(addr);
+            bank = tagArray.mapIndexToBank(set);
+        }
+        return m_tag_refresh;
+    } else if (res == CacheResourceType_DataArray) {
+        if (m_data_refresh) {
+            set = addressToCacheSet(addr);
+            bank = dataArray.mapIndexToBank(set);
+        }
+        return m_data_refresh;
     } else {
         panic("Unrecognized cache resource type.");
     }
+}
+
+bool
+CacheMemory::inRefresh(CacheResourceType res, Addr addr, Cycles cycle)
+{
+    unsigned int bank;
+    int64_t set;
+    RefreshController *refresh = refreshBank(res, addr, bank, set);
+    return refresh && refresh->inRefresh(bank, set, cycle);
+}
+
+Cycles
+CacheMemory::refreshEndCycle(CacheResourceType res, Addr addr, Cycles cycle)
+{
+    unsigned int bank;
+    int64_t set;
+    RefreshController *refresh = refreshBank(res, addr, bank, set);
+    return refresh ? refresh->refreshEndCycle(bank, set, cycle) : cycle;
+}
+
+Cycles
+CacheMemory::nextAvailableCycle(CacheResourceType res, Addr addr,
+                                Cycles cycle)
+{
+    if (m_resource_stalls) {
+        if (res == CacheResourceType_TagArray) {
+            cycle = tagArray.nextAvailableCycle(addressToCacheSet(addr),
+                                                cycle);
+        } else if (res == CacheResourceType_DataArray) {
+            cycle = dataArray.nextAvailableCycle(addressToCacheSet(addr),
+                                                 cycle);
+        } else {
+            panic("Unrecognized cache resource type.");
+        }
+    }
+
+    // The refresh controller keeps the latency below the period, so a
+    // refresh ends before the next one of the bank starts and this takes
+    // at most a couple of steps
+    for (Cycles end = refreshEndCycle(res, addr, cycle); end != cycle;
+         end = refreshEndCycle(res, addr, cycle)) {
+        cycle = end;
+    }
+    return cycle;
+}
+
+void
+CacheMemory::noteValidLines(int64_t cache_set, int delta)
+{
+    if (m_data_refresh) {
+        m_data_refresh->noteValidLines(dataArray.mapIndexToBank(cache_set),
+                                       cache_set, delta);
+    }
+    if (m_tag_refresh) {
+        m_tag_refresh->noteValidLines(tagArray.mapIndexToBank(cache_set),
+                                      cache_set, delta);
+    }
+}
+
+void
+CacheMemory::noteRefreshDemand(CacheResourceType res, Addr addr, Cycles end)
+{
+    unsigned int bank;
+    int64_t set;
+    RefreshController *refresh = refreshBank(res, addr, bank, set);
+    if (refresh)
+        refresh->noteAccess(bank, end);
+}
+
+bool
+CacheMemory::keepRow(unsigned int bank, int64_t first, int64_t end)
+{
+    std::vector<AbstractCacheEntry*> dead;
+    for (int64_t index = first; index < end; index++) {
+        int64_t cache_set = index * dataArray.banks + bank;
+        if (cache_set >= m_cache_num_sets)
+            break;
+        for (int way = 0; way < m_cache_assoc; way++) {
+            AbstractCacheEntry *entry = m_cache[cache_set][way];
+            if (!entry || m_expired[cache_set][way] ||
+                entry->m_Permission == AccessPermission_Invalid ||
+                entry->m_Permission == AccessPermission_NotPresent)
+                continue;
+            // An L1 owns the data of a Maybe_Stale line, so it needs no
+            // refresh, but it stays allocated for its owner
+            if (entry->m_Permission == AccessPermission_Maybe_Stale)
+                continue;
+            // Stable lines no L1 holds may expire; the protocol writes
+            // the dirty ones back when it replaces them. Busy lines, and
+            // lines L1 hits keep using without touching this cache, keep
+            // their rows refreshed.
+            if ((entry->m_Permission != AccessPermission_Read_Only &&
+                 entry->m_Permission != AccessPermission_Read_Write) ||
+                entry->isCachedAbove() ||
+                !m_dead_block->predictDead(idleCycles(entry)))
+                return true;
+            dead.push_back(entry);
+        }
+    }
 
-    return 0;
+    for (auto entry : dead) {
+        DPRINTF(RubyCache, "%#x expires as predicted dead\n",
+                entry->m_Address);
+        m_expired[entry->getSet()][entry->getWay()] = true;
+        std::shared_ptr<RubyRequest> msg =
+            std::make_shared<RubyRequest>(m_ruby_system->clockEdge(),
+                                          entry->m_Address, m_block_size,
+                                          0, // pc
+                                          RubyRequestType_REPLACEMENT,
+                                          RubyAccessMode_Supervisor,
+                                          nullptr);
+        m_expired_queue->enqueue(msg, m_ruby_system->clockEdge(),
+                                 m_ruby_system->cyclesToTicks(Cycles(1)));
+    }
+    m_dead_block->noteExpired(dead.size());
+    return false;
+}
+
+Cycles
+CacheMemory::idleCycles(const AbstractCacheEntry *entry) const
+{
+    return Cycles((curTick() - entry->getLastAccess()) /
+                  m_ruby_system->clockPeriod());
+}
 
+void
+CacheMemory::noteLineAccess(const AbstractCacheEntry *entry)
+{
+    if (!m_dead_block || !m_expired[entry->getSet()][entry->getWay()])
+        return;
+    // The line was not dead; its data was lost, so this access is the
+    // miss the prediction caused
+    DPRINTF(RubyCache, "%#x accessed after it expired\n", entry->m_Address);
+    m_expired[entry->getSet()][entry->getWay()] = false;
+    m_dead_block->noteRevived();
+}
+
+void
+CacheMemory::noteRefill(int64_t cache_set, int way, Addr address)
+{
+    // Fetched again after it expired, the refetch is the miss the
+    // prediction caused
+    for (int i = 0; i < m_cache_assoc; i++) {
+        if (m_expired_shadow[cache_set][i] == address) {
+            DPRINTF(RubyCache, "%#x fetched again after it expired\n",
+                    address);
+            m_expired_shadow[cache_set][i] = MaxAddr;
+            m_dead_block->noteRevived();
+        }
+    }
+    // Its way holds another line before it was fetched again
+    if (m_expired_shadow[cache_set][way] != MaxAddr) {
+        m_expired_shadow[cache_set][way] = MaxAddr;
+        m_dead_block->noteEvicted();
+    }
+}
+
+bool
+CacheMemory::isExpired(Addr address)
+{
+    AbstractCacheEntry *entry = lookup(address);
+    return m_dead_block && entry &&
+           m_expired[entry->getSet()][entry->getWay()];
+}
+
+Cycles
+CacheMemory::refreshDelay(CacheResourceType res, Addr addr, Cycles cycle)
+{
+    return refreshEndCycle(res, addr, cycle) - cycle;
+}
+
+void
+CacheMemory::noteRefreshCollision(CacheResourceType res, Addr addr,
+                                  Cycles cycle)
+{
+    Cycles delay = refreshDelay(res, addr, cycle);
+    if (delay == 0)
+        return;
+
+    if (res == CacheResourceType_TagArray) {
+        cacheMemoryStats.numTagArrayRefreshCollisions++;
+        cacheMemoryStats.tagArrayRefreshDelay.sample(delay);
+    } else {
+        cacheMemoryStats.numDataArrayRefreshCollisions++;
+        cacheMemoryStats.dataArrayRefreshDelay.sample(delay);
+    }
+}
+
+/**
+ * Read the per-bank refresh offsets NS-Cache writes with -RefreshSchedule.
+ * Each non-comment line is "<data|tag> <bank> <offset> <duration> <period>"
+ * in cycles; the duration and period are already the latency and period
+ * of the refresh controllers.
+ */
+void
+CacheMemory::loadRefreshSchedule(const std::string &file_name)
+{
+    std::ifstream file(file_name);
+    if (!file.is_open())
+        fatal("Cannot open refresh schedule %s\n", file_name);
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#')
+            continue;
+        std::istringstream fields(line);
+        std::string array;
+        unsigned int bank;
+        uint64_t offset, duration, period;
+        if (!(fields >> array >> bank >> offset >> duration >> period))
+            fatal("Malformed line in refresh schedule %s: %s\n",
+                  file_name, line);
+
+        std::vector<Cycles> *offsets;
+        if (array == "data")
+            offsets = &m_data_refresh_offset;
+        else if (array == "tag")
+            offsets = &m_tag_refresh_offset;
+        else
+            fatal("Unknown array %s in refresh schedule %s\n",
+                  array, file_name);
+        if (offsets->size() <= bank)
+            offsets->resize(bank + 1, Cycles(0));
+        (*offsets)[bank] = Cycles(offset);
+    }
+
+    if (m_data_refresh_offset.size() != dataArray.banks ||
+        (!m_tag_refresh_offset.empty() &&
+         m_tag_refresh_offset.size() != tagArray.banks)) {
+        warn("Refresh schedule %s has %d data and %d tag banks, the cache "
+             "has %d and %d; the offsets repeat over the banks\n",
+             file_name, m_data_refresh_offset.size(),
+             m_tag_refresh_offset.size(), dataArray.banks, tagArray.banks);
+    }
 }
 
 bool
@@ -57,6 +57,8 @@
 #include "mem/ruby/slicc_interface/RubySlicc_ComponentMapping.hh"
 #include "mem/ruby/structures/BankedArray.hh"
 #include "mem/ruby/structures/ALUFreeListArray.hh"
+#include "mem/ruby/structures/DeadBlockPredictor.hh"
+#include "mem/ruby/structures/RefreshController.hh"
 #include "mem/ruby/system/CacheRecorder.hh"
 #include "params/RubyCache.hh"
 #include "sim/sim_object.hh"
@@ -67,6 +69,8 @@ namespace gem5
 namespace ruby
 {
 
+class MessageBuffer;
+
 class CacheMemory : public SimObject
 {
   public:
@@ -153,7 +157,23 @@ class CacheMemory : public SimObject
     void recordRequestTypeSpecf(CacheRequestType requestType, Addr addr,
       Cycles access_time, Cycles init_cycle);
 
-    int getRefreshStartPoint(CacheResourceType res, Addr addr);
+    // Refresh of the bank of the array holding addr, see
+    // RefreshController; never refreshing if the array has none
+    bool inRefresh(CacheResourceType res, Addr addr, Cycles cycle);
+    Cycles refreshEndCycle(CacheResourceType res, Addr addr, Cycles cycle);
+    // The first cycle from the given one at which the bank of the array
+    // holding addr is neither busy nor refreshing the set of addr, so
+    // protocols can delay or wake a message by exactly that much
+    Cycles nextAvailableCycle(CacheResourceType res, Addr addr,
+                              Cycles cycle);
+    // Cycles until that refresh is over, 0 if the bank is not refreshing;
+    // protocols charge it to the access. It only queries, the collision
+    // is counted once when the access is recorded
+    Cycles refreshDelay(CacheResourceType res, Addr addr, Cycles cycle);
+    // Whether the data row of the line expired as predicted dead; the
+    // protocol replaces such lines from the expired line queue
+    bool isExpired(Addr address);
+    void loadRefreshSchedule(const std::string &file_name);
 
     // hardware transactional memory
     void htmAbortTransaction();
@@ -174,6 +194,27 @@ class CacheMemory : public SimObject
     int findTagInSet(int64_t line, Addr tag) const;
     int findTagInSetIgnorePermissions(int64_t cacheSet, Addr tag) const;
 
+    // The refresh controller of the array, and the bank and set
+    // holding addr
+    RefreshController *refreshBank(CacheResourceType res, Addr addr,
+                                   unsigned int &bank, int64_t &set);
+    // Counts an access the refresh of its bank delays, and by how much
+    void noteRefreshCollision(CacheResourceType res, Addr addr, Cycles cycle);
+    // Lets the refresh controller see the demand on the bank
+    void noteRefreshDemand(CacheResourceType res, Addr addr, Cycles end);
+    // Lets the refresh controllers see which rows hold valid lines
+    void noteValidLines(int64_t cache_set, int delta);
+    // Whether the sets [first, end) of the data bank hold a line that
+    // needs refresh; if not, their lines predicted dead expire
+    bool keepRow(unsigned int bank, int64_t first, int64_t end);
+    // Cycles since the last access of the line
+    Cycles idleCycles(const AbstractCacheEntry *entry) const;
+    // Resolves the dead-block prediction of a line accessed again
+    void noteLineAccess(const AbstractCacheEntry *entry);
+    // Resolves the predictions of the lines that expired out of the set
+    // when a line is allocated into the way
+    void noteRefill(int64_t cache_set, int way, Addr address);
+
     // Private copy constructor and assignment operator
     CacheMemory(const CacheMemory& obj);
     CacheMemory& operator=(const CacheMemory& obj);
@@ -202,6 +243,24 @@ class CacheMemory : public SimObject
     bool m_resource_stalls;
     int m_block_size;
 
+    // Refresh window offset of each bank in cycles, loaded from the
+    // NS-Cache refresh schedule and handed to the refresh controllers.
+    // Empty means every bank starts at 0.
+    std::vector<Cycles> m_data_refresh_offset;
+    std::vector<Cycles> m_tag_refresh_offset;
+    RefreshController *m_data_refresh;
+    RefreshController *m_tag_refresh;
+    // Lines whose data array row expired as predicted dead, by set and
+    // way; only sized with a predictor
+    DeadBlockPredictor *m_dead_block;
+    std::vector<std::vector<bool>> m_expired;
+    // Where the expired lines are queued for the protocol to replace
+    MessageBuffer *m_expired_queue;
+    // The address of the last expired line replaced out of each way until
+    // its prediction is resolved, MaxAddr if none
+    std::vector<std::vector<Addr>> m_expired_shadow;
+    RubySystem *m_ruby_system;
+
     /**
      * We store all the ReplacementData in a 2-dimensional array. By doing
      * this, we can use all replacement policies from Classic system. Ruby
@@ -234,6 +293,12 @@ class CacheMemory : public SimObject
           statistics::Scalar numAtomicALUOperations;
           statistics::Scalar numAtomicALUArrayStalls;
 
+          // accesses that had to wait for a refresh, and how long
+          statistics::Scalar numDataArrayRefreshCollisions;
+          statistics::Scalar numTagArrayRefreshCollisions;
+          statistics::Histogram dataArrayRefreshDelay;
+          statistics::Histogram tagArrayRefreshDelay;
+
           // hardware transactional memory
           statistics::Histogram htmTransCommitReadSet;
           statistics::Histogram htmTransCommitWriteSet;
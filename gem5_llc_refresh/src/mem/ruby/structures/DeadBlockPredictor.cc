@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2025 Georgia Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/structures/DeadBlockPredictor.hh"
+
+#include <algorithm>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/RubyRefresh.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+DeadBlockPredictor::DeadBlockPredictor(const Params &p)
+    : SimObject(p), m_decay(p.decay),
+      m_min_decay(p.min_decay == 0 ? p.decay : p.min_decay),
+      m_max_decay(p.max_decay == 0 ? p.decay : p.max_decay),
+      m_adapt_interval(p.adapt_interval), m_correct_run(0),
+      stats(this)
+{
+    fatal_if(m_decay == 0, "%s: the decay must be positive\n", name());
+    fatal_if(m_min_decay > m_decay || m_decay > m_max_decay,
+             "%s: decay %d is outside [%d, %d]\n", name(), m_decay,
+             m_min_decay, m_max_decay);
+}
+
+DeadBlockPredictor::DeadBlockStats::DeadBlockStats(
+    statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(expired, "Number of lines predicted dead that expired "
+                        "instead of being refreshed"),
+      ADD_STAT(correct, "Number of expired lines whose way held another "
+                        "line before they were fetched again"),
+      ADD_STAT(mispredicted, "Number of expired lines fetched again, "
+                             "each a miss the prediction caused"),
+      ADD_STAT(accuracy, "Fraction of the resolved predictions that "
+                         "were correct")
+{
+    accuracy = correct / (correct + mispredicted);
+    accuracy
+        .flags(statistics::nozero | statistics::nonan);
+}
+
+void
+DeadBlockPredictor::noteExpired(unsigned int lines)
+{
+    stats.expired += lines;
+}
+
+void
+DeadBlockPredictor::noteRevived()
+{
+    stats.mispredicted++;
+    m_correct_run = 0;
+    Cycles decay = std::min(Cycles(m_decay * 2), m_max_decay);
+    if (decay != m_decay) {
+        DPRINTF(RubyRefresh, "Dead-block decay raised to %d cycles\n",
+                decay);
+        m_decay = decay;
+    }
+}
+
+void
+DeadBlockPredictor::noteEvicted()
+{
+    stats.correct++;
+    if (++m_correct_run < m_adapt_interval)
+        return;
+    m_correct_run = 0;
+    Cycles decay = std::max(Cycles(m_decay / 2), m_min_decay);
+    if (decay != m_decay) {
+        DPRINTF(RubyRefresh, "Dead-block decay lowered to %d cycles\n",
+                decay);
+        m_decay = decay;
+    }
+}
+
+} // namespace ruby
+} // namespace gem5
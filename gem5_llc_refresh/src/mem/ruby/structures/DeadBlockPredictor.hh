@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2025 Georgia Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_STRUCTURES_DEADBLOCKPREDICTOR_HH__
+#define __MEM_RUBY_STRUCTURES_DEADBLOCKPREDICTOR_HH__
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "params/RubyDeadBlockPredictor.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * Decay-based dead-block prediction for the refresh of a CacheMemory.
+ *
+ * A line without an access for decay cycles is predicted dead. The
+ * cache lets a row expire instead of refreshing it once every line the
+ * row holds is stable and predicted dead, and the protocol replaces those
+ * lines, writing the dirty ones back. An expired line that is fetched
+ * again was mispredicted and its refetch is a miss the prediction
+ * caused; one whose way holds another line first was predicted right.
+ * The decay doubles on every misprediction and halves after
+ * adapt_interval correct predictions in a row, within
+ * [min_decay, max_decay].
+ */
+class DeadBlockPredictor : public SimObject
+{
+  public:
+    typedef RubyDeadBlockPredictorParams Params;
+    DeadBlockPredictor(const Params &p);
+
+    // Whether a line idle for the given cycles is predicted dead
+    bool predictDead(Cycles idle) const { return idle >= m_decay; }
+    Cycles getDecay() const { return m_decay; }
+
+    // The lines of a row expired instead of being refreshed
+    void noteExpired(unsigned int lines);
+    // An expired line was fetched again
+    void noteRevived();
+    // The way of an expired line holds another line
+    void noteEvicted();
+
+  private:
+    Cycles m_decay;
+    Cycles m_min_decay;
+    Cycles m_max_decay;
+    unsigned int m_adapt_interval;
+    // Correct predictions since the last misprediction or adaptation
+    unsigned int m_correct_run;
+
+    struct DeadBlockStats : public statistics::Group
+    {
+        DeadBlockStats(statistics::Group *parent);
+
+        statistics::Scalar expired;
+        statistics::Scalar correct;
+        statistics::Scalar mispredicted;
+        statistics::Formula accuracy;
+    } stats;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_STRUCTURES_DEADBLOCKPREDICTOR_HH__
@@ -0,0 +1,498 @@
+/*
+ * Copyright (c) 2025 Georgia Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "mem/ruby/structures/RefreshController.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include "base/logging.hh"
+#include "base/random.hh"
+#include "base/trace.hh"
+#include "debug/RubyRefresh.hh"
+#include "mem/ruby/system/RubySystem.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+RefreshController::RefreshController(const Params &p)
+    : SimObject(p), m_period(p.period), m_latency(p.latency),
+      m_max_postponed(p.max_postponed), m_max_pulled_in(p.max_pulled_in),
+      m_idle_threshold(p.idle_threshold), m_rows(p.rows),
+      m_skip_invalid(p.skip_invalid), m_distributed(p.distributed),
+      m_energy_per_refresh(p.energy_per_refresh),
+      m_retention_time(p.retention_time),
+      m_bins(p.retention_bins.begin(), p.retention_bins.end()),
+      m_bin_multipliers(p.bin_multipliers.begin(), p.bin_multipliers.end()),
+      m_bin_fractions(p.bin_fractions.begin(), p.bin_fractions.end()),
+      m_retention_profile(p.retention_profile), m_row_groups(1),
+      m_sets_per_bank(1),
+      m_ruby_system(p.ruby_system),
+      refreshEvent([this]{ processRefreshEvent(); }, name()),
+      stats(this)
+{
+    fatal_if(m_period == 0, "%s: the refresh period must be positive\n",
+             name());
+    fatal_if(m_rows == 0, "%s: a bank needs at least one row\n", name());
+
+    if (elastic() && p.retention_time > 0) {
+        Cycles period(p.retention_time /
+                      (p.rows + m_max_postponed + m_max_pulled_in));
+        if (period < m_period) {
+            inform("%s: refresh period cut from %d to %d cycles to keep "
+                   "%d rows within the retention time with %d postponed "
+                   "and %d pulled-in refreshes\n", name(), m_period,
+                   period, p.rows, m_max_postponed, m_max_pulled_in);
+            m_period = period;
+        }
+    }
+    // A bank refreshing for its whole period is never available, so
+    // nothing waiting for the end of a refresh could ever proceed
+    fatal_if(m_latency >= m_period,
+             "%s: refresh latency %d must be below the refresh period %d\n",
+             name(), m_latency, m_period);
+
+    if (!m_bins.empty()) {
+        fatal_if(m_bin_multipliers.size() != m_bins.size() + 1,
+                 "%s: %d retention bins need %d multipliers, one for the "
+                 "rows in no bin\n", name(), m_bins.size(),
+                 m_bins.size() + 1);
+        for (unsigned int i = 0; i < m_bin_multipliers.size(); i++) {
+            fatal_if(m_bin_multipliers[i] == 0 ||
+                     (i > 0 && m_bin_multipliers[i] <
+                      m_bin_multipliers[i - 1]),
+                     "%s: bin multipliers must be positive and rising\n",
+                     name());
+        }
+        fatal_if(m_retention_profile.empty() &&
+                 m_bin_fractions.size() != m_bins.size(),
+                 "%s: %d retention bins need %d bin fractions\n", name(),
+                 m_bins.size(), m_bins.size());
+        fatal_if(!m_retention_profile.empty() && m_retention_time == 0,
+                 "%s: a retention profile needs the retention time\n",
+                 name());
+    }
+}
+
+RefreshController::RefreshStats::RefreshStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(refreshes, "Number of bank refreshes issued"),
+      ADD_STAT(postponed, "Number of refreshes postponed under demand"),
+      ADD_STAT(pulledIn, "Number of refreshes pulled in by idle banks"),
+      ADD_STAT(forced, "Number of refreshes forced under demand after "
+                       "the maximum postponement"),
+      ADD_STAT(skipped, "Number of refreshes skipped for rows without "
+                        "valid lines"),
+      ADD_STAT(retentionSkipped, "Number of refreshes skipped for rows "
+                                 "in a longer retention bin"),
+      ADD_STAT(expired, "Number of refreshes skipped for rows the cache "
+                        "let expire"),
+      ADD_STAT(binRows, "Number of rows in each retention bin"),
+      ADD_STAT(bankRefreshes, "Number of refreshes of each bank"),
+      ADD_STAT(bankRefreshCycles, "Cycles each bank spent refreshing"),
+      ADD_STAT(energy, "Refresh energy (J), from energy_per_refresh")
+{
+    energy
+        .flags(statistics::nozero);
+    retentionSkipped
+        .flags(statistics::nozero);
+    expired
+        .flags(statistics::nozero);
+}
+
+void
+RefreshController::setBanks(unsigned int banks, int64_t sets,
+                            const std::vector<Cycles> &offsets)
+{
+    // Sets are interleaved over the banks; the rows of a bank are
+    // tracked in groups of consecutive sets, a set may span rows
+    m_sets_per_bank = std::max<int64_t>(1, (sets + banks - 1) / banks);
+    m_row_groups = std::min<uint64_t>(m_rows, m_sets_per_bank);
+    m_valid_lines.assign(banks * m_row_groups, 0);
+    stats.bankRefreshes.init(banks).flags(statistics::total);
+    stats.bankRefreshCycles.init(banks).flags(statistics::total);
+    stats.binRows.init(std::max<size_t>(1, m_bin_multipliers.size()))
+        .flags(statistics::total | statistics::nozero);
+
+    m_banks.resize(banks);
+    for (unsigned int i = 0; i < banks; i++) {
+        BankRefresh &bank = m_banks[i];
+        bank.offset = offsets.empty() ? Cycles(0) :
+            Cycles(offsets[i % offsets.size()] % m_period);
+        bank.nextSlot = nextWindowStart(bank, Cycles(0));
+        bank.windowStart = bank.nextSlot;
+        bank.windowEnd = bank.windowStart + m_latency;
+        bank.refreshing = false;
+        bank.owed = 0;
+        bank.row = 0;
+        bank.nextRow = 0;
+        bank.round = 0;
+        bank.busyUntil = Cycles(0);
+        bank.nextEvaluation = Cycles(0);
+    }
+
+    if (!m_bins.empty())
+        assignBins();
+}
+
+void
+RefreshController::assignBins()
+{
+    // Retention in cycles of each row of the profile, "<bank> <row>
+    // <retention>" per line
+    std::map<Addr, uint64_t> profile;
+    if (!m_retention_profile.empty()) {
+        std::ifstream file(m_retention_profile);
+        if (!file.is_open())
+            fatal("%s: cannot open retention profile %s\n", name(),
+                  m_retention_profile);
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty() || line[0] == '#')
+                continue;
+            std::istringstream fields(line);
+            unsigned int bank, row;
+            uint64_t retention;
+            if (!(fields >> bank >> row >> retention))
+                fatal("%s: malformed line in retention profile %s: %s\n",
+                      name(), m_retention_profile, line);
+            if (bank < m_banks.size() && row < m_rows)
+                profile[rowKey(bank, row)] = retention;
+        }
+    }
+
+    unsigned int unprofiled = 0;
+    for (unsigned int bank = 0; bank < m_banks.size(); bank++) {
+        for (unsigned int row = 0; row < m_rows; row++) {
+            unsigned int bin = 0;
+            if (!m_retention_profile.empty()) {
+                // Rows the profile misses keep the worst-case rate
+                auto it = profile.find(rowKey(bank, row));
+                if (it != profile.end())
+                    bin = retentionBin(it->second);
+                else
+                    unprofiled++;
+            } else {
+                double draw = random_mt.random<double>();
+                while (bin < m_bin_fractions.size() &&
+                       draw >= m_bin_fractions[bin]) {
+                    draw -= m_bin_fractions[bin];
+                    bin++;
+                }
+            }
+            stats.binRows[bin]++;
+            if (bin < m_bins.size())
+                m_bins[bin]->set(rowKey(bank, row));
+        }
+    }
+    warn_if(unprofiled > 0, "%s: %d rows missing from retention profile "
+            "%s are refreshed at the shortest period\n", name(),
+            unprofiled, m_retention_profile);
+}
+
+unsigned int
+RefreshController::retentionBin(uint64_t retention) const
+{
+    // The longest bin whose period still fits in the retention
+    unsigned int bin = 0;
+    while (bin + 1 < m_bin_multipliers.size() &&
+           m_bin_multipliers[bin + 1] * m_retention_time <= retention)
+        bin++;
+    return bin;
+}
+
+unsigned int
+RefreshController::rowMultiplier(unsigned int bank, unsigned int row) const
+{
+    for (unsigned int bin = 0; bin < m_bins.size(); bin++) {
+        if (m_bins[bin]->isSet(rowKey(bank, row)))
+            return m_bin_multipliers[bin];
+    }
+    return m_bin_multipliers.back();
+}
+
+void
+RefreshController::startup()
+{
+    if (!enabled())
+        return;
+
+    Cycles now = curCycle();
+    for (unsigned int i = 0; i < m_banks.size(); i++)
+        evaluate(i, now);
+    scheduleRefreshEvent();
+}
+
+Cycles
+RefreshController::curCycle() const
+{
+    return m_ruby_system->curCycle();
+}
+
+Cycles
+RefreshController::nextWindowStart(const BankRefresh &bank,
+                                   Cycles cycle) const
+{
+    Cycles first = bank.offset + m_period - m_latency;
+    if (cycle < first + m_latency)
+        return first;
+    uint64_t windows = (cycle - first - m_latency) / m_period + 1;
+    return Cycles(first + windows * m_period);
+}
+
+unsigned int
+RefreshController::setGroup(int64_t set) const
+{
+    return (set / m_banks.size()) * m_row_groups / m_sets_per_bank;
+}
+
+unsigned int
+RefreshController::rowGroup(unsigned int row) const
+{
+    return row * m_row_groups / m_rows;
+}
+
+int64_t
+RefreshController::groupStart(unsigned int group) const
+{
+    // The inverse of setGroup, rounded up
+    return ((int64_t)group * m_sets_per_bank + m_row_groups - 1) /
+        m_row_groups;
+}
+
+bool
+RefreshController::refreshCovering(unsigned int bank, int64_t set,
+                                   Cycles cycle, Cycles &end) const
+{
+    assert(bank < m_banks.size());
+    const BankRefresh &state = m_banks[bank];
+
+    Cycles start = state.windowStart;
+    unsigned int row = state.row;
+    if (issuedOnly()) {
+        // Refreshes are only known once they are issued
+        if (!state.refreshing)
+            return false;
+    } else if (cycle >= state.windowEnd ||
+               cycle + m_period < state.windowEnd) {
+        // The tracked window answers everything from the end of the
+        // one before it; anything else, e.g. a cycle far ahead of the
+        // event, falls back to the arithmetic, where the k-th window
+        // refreshes row k
+        start = nextWindowStart(state, cycle);
+        Cycles first = nextWindowStart(state, Cycles(0));
+        row = uint64_t(start - first) / m_period % m_rows;
+    }
+    end = start + m_latency;
+    if (m_distributed && rowGroup(row) != setGroup(set))
+        return false;
+    return cycle >= start && cycle < end;
+}
+
+bool
+RefreshController::inRefresh(unsigned int bank, int64_t set,
+                             Cycles cycle) const
+{
+    Cycles end;
+    return enabled() && refreshCovering(bank, set, cycle, end);
+}
+
+Cycles
+RefreshController::refreshEndCycle(unsigned int bank, int64_t set,
+                                   Cycles cycle) const
+{
+    Cycles end;
+    if (enabled() && refreshCovering(bank, set, cycle, end))
+        return end;
+    return cycle;
+}
+
+void
+RefreshController::noteAccess(unsigned int bank, Cycles end)
+{
+    if (!enabled())
+        return;
+    assert(bank < m_banks.size());
+    if (end > m_banks[bank].busyUntil)
+        m_banks[bank].busyUntil = end;
+}
+
+void
+RefreshController::noteValidLines(unsigned int bank, int64_t set, int delta)
+{
+    if (!enabled() || !m_skip_invalid)
+        return;
+    unsigned int group = setGroup(set);
+    assert(bank < m_banks.size() && group < m_row_groups);
+    m_valid_lines[bank * m_row_groups + group] += delta;
+}
+
+void
+RefreshController::evaluate(unsigned int bank, Cycles now)
+{
+    BankRefresh &state = m_banks[bank];
+    if (state.refreshing) {
+        if (now < state.windowEnd) {
+            planEvaluation(bank, state.windowEnd);
+            return;
+        }
+        state.refreshing = false;
+    }
+
+    // Every slot that went by owes one more refresh
+    int arrived = 0;
+    while (state.nextSlot <= now) {
+        state.owed++;
+        state.nextSlot += m_period;
+        arrived++;
+    }
+
+    Cycles idle_from = state.busyUntil + m_idle_threshold;
+    bool idle = now >= idle_from;
+    // A skipped refresh takes no time, so the bank decides again
+    if (state.owed > (int)m_max_postponed) {
+        if (!issueRefresh(bank, now))
+            evaluate(bank, now);
+        else if (elastic() && !idle)
+            stats.forced++;
+        return;
+    } else if (state.owed > 0) {
+        if (idle) {
+            if (!issueRefresh(bank, now))
+                evaluate(bank, now);
+            return;
+        }
+        stats.postponed += arrived;
+    } else if (idle && state.owed > -(int)m_max_pulled_in) {
+        if (!issueRefresh(bank, now))
+            evaluate(bank, now);
+        else
+            stats.pulledIn++;
+        return;
+    }
+
+    state.windowStart = state.nextSlot;
+    state.windowEnd = state.windowStart + m_latency;
+    state.row = state.nextRow;
+    // An owed or pull-in refresh waits for the bank to go idle
+    bool waits_for_idle = state.owed > 0 ||
+        state.owed > -(int)m_max_pulled_in;
+    if (waits_for_idle && !idle && idle_from < state.nextSlot)
+        planEvaluation(bank, idle_from);
+    else
+        planEvaluation(bank, state.nextSlot);
+}
+
+bool
+RefreshController::issueRefresh(unsigned int bank, Cycles now)
+{
+    BankRefresh &state = m_banks[bank];
+    unsigned int row = state.nextRow;
+    uint64_t round = state.round;
+    state.nextRow = (row + 1) % m_rows;
+    if (state.nextRow == 0)
+        state.round++;
+    state.owed--;
+    if (!m_bins.empty() && round % rowMultiplier(bank, row) != 0) {
+        stats.retentionSkipped++;
+        DPRINTF(RubyRefresh, "Bank %d skips the refresh of row %d, not "
+                "due in round %d at cycle %d\n", bank, row, round, now);
+        return false;
+    }
+    unsigned int group = rowGroup(row);
+    if (m_skip_invalid && m_valid_lines[bank * m_row_groups + group] == 0) {
+        stats.skipped++;
+        DPRINTF(RubyRefresh, "Bank %d skips the refresh of row %d without "
+                "valid lines at cycle %d\n", bank, row, now);
+        return false;
+    }
+    if (m_expiry_check &&
+        !m_expiry_check(bank, groupStart(group), groupStart(group + 1))) {
+        stats.expired++;
+        DPRINTF(RubyRefresh, "Bank %d lets row %d expire at cycle %d\n",
+                bank, row, now);
+        return false;
+    }
+
+    state.refreshing = true;
+    state.row = row;
+    state.windowStart = now;
+    state.windowEnd = now + m_latency;
+    stats.refreshes++;
+    stats.bankRefreshes[bank]++;
+    stats.bankRefreshCycles[bank] += m_latency;
+    stats.energy += m_energy_per_refresh;
+    DPRINTF(RubyRefresh, "Bank %d refreshes row %d from cycle %d to %d, "
+            "%d refreshes owed\n", bank, row, state.windowStart,
+            state.windowEnd, state.owed);
+    planEvaluation(bank, state.windowEnd);
+    return true;
+}
+
+void
+RefreshController::planEvaluation(unsigned int bank, Cycles cycle)
+{
+    m_banks[bank].nextEvaluation = cycle;
+    m_transitions.push(Transition(cycle, bank));
+}
+
+void
+RefreshController::processRefreshEvent()
+{
+    Cycles now = curCycle();
+    while (!m_transitions.empty() && m_transitions.top().first <= now) {
+        Transition transition = m_transitions.top();
+        m_transitions.pop();
+        if (transition.first == m_banks[transition.second].nextEvaluation)
+            evaluate(transition.second, now);
+    }
+    scheduleRefreshEvent();
+}
+
+void
+RefreshController::scheduleRefreshEvent()
+{
+    if (m_transitions.empty())
+        return;
+
+    Tick when = std::max(curTick(), m_transitions.top().first *
+                         m_ruby_system->clockPeriod());
+    if (!refreshEvent.scheduled())
+        schedule(refreshEvent, when);
+    else if (when < refreshEvent.when())
+        reschedule(refreshEvent, when);
+}
+
+} // namespace ruby
+} // namespace gem5
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2025 Georgia Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_STRUCTURES_REFRESHCONTROLLER_HH__
+#define __MEM_RUBY_STRUCTURES_REFRESHCONTROLLER_HH__
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/filters/base.hh"
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "params/RubyRefreshController.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+class RubySystem;
+
+/**
+ * Refresh of the banks of one array (data or tag) of a CacheMemory.
+ *
+ * Every bank is due one refresh of latency cycles per period, in the
+ * slot [offset + k * period + period - latency, offset + (k + 1) * period)
+ * where offset comes from the NS-Cache refresh schedule. An event at
+ * every slot, refresh end, and idle point decides when each bank
+ * refreshes, so protocols look a bank up instead of redoing the modulo
+ * arithmetic on every access.
+ *
+ * By default a bank refreshes in its slots. Elastic refresh, as in DDR
+ * controllers, lets a bank with recent demand postpone up to
+ * max_postponed refreshes and catch up once it goes idle, and lets an
+ * idle bank pull up to max_pulled_in refreshes in ahead of their slots.
+ * A refresh owed beyond max_postponed is forced even under demand. As
+ * each row is refreshed once every rows refreshes, the period is cut
+ * so that (rows + max_postponed + max_pulled_in) periods still fit in
+ * the retention time.
+ *
+ * With skip_invalid, a refresh of a row group whose sets hold no
+ * allocated line is skipped and takes no time.
+ *
+ * A refresh blocks the whole bank unless distributed is set, in which
+ * case it only blocks the sets of the row group it refreshes and the
+ * rest of the bank keeps serving demand. The sets of a bank are split
+ * into min(rows, sets per bank) row groups of consecutive sets.
+ *
+ * Multi-rate refresh, as in RAIDR, bins the rows by retention time: a
+ * row of a bin with multiplier m is only refreshed every m-th time its
+ * turn comes, and the other turns are skipped. Bin membership is kept
+ * in one bloom filter per bin, checked from the shortest retention up,
+ * so a false positive only refreshes a row more often than needed.
+ * Rows in no filter belong to the last, longest bin. Rows are binned
+ * from a per-row retention profile, or drawn from bin_fractions.
+ *
+ * The owning cache may also check each row group before its refresh,
+ * see setExpiryCheck, and let it expire instead.
+ */
+class RefreshController : public SimObject
+{
+  public:
+    typedef RubyRefreshControllerParams Params;
+    RefreshController(const Params &p);
+
+    void startup() override;
+
+    // Called by the owning CacheMemory once its banks are known;
+    // offsets are per bank and repeat if there are fewer of them
+    void setBanks(unsigned int banks, int64_t sets,
+                  const std::vector<Cycles> &offsets);
+
+    // Whether the refresh of the bank blocks the cache set during the
+    // given cycle
+    bool inRefresh(unsigned int bank, int64_t set, Cycles cycle) const;
+    // The first cycle after the refresh of the bank that blocks the set
+    // in the given cycle, or the cycle itself if there is none
+    Cycles refreshEndCycle(unsigned int bank, int64_t set,
+                           Cycles cycle) const;
+
+    // A demand access keeps the bank busy until the end cycle
+    void noteAccess(unsigned int bank, Cycles end);
+    // A line of the cache set was allocated (+1) or deallocated (-1)
+    void noteValidLines(unsigned int bank, int64_t set, int delta);
+
+    // Called with the bank and the range [first, end) of set indices
+    // within the bank of each row group due for refresh; false skips
+    // the refresh and lets the row expire
+    typedef std::function<bool(unsigned int, int64_t, int64_t)>
+        ExpiryCheck;
+    void setExpiryCheck(const ExpiryCheck &check) { m_expiry_check = check; }
+
+    bool enabled() const { return m_latency > 0 && !m_banks.empty(); }
+    bool elastic() const { return m_max_postponed > 0 || m_max_pulled_in > 0; }
+    // Whether refreshes are only known once issued, as some are skipped
+    // or moved
+    bool issuedOnly() const
+    {
+        return elastic() || m_skip_invalid || !m_bins.empty() ||
+            m_expiry_check;
+    }
+    Cycles getPeriod() const { return m_period; }
+    Cycles getLatency() const { return m_latency; }
+    Cycles curCycle() const;
+
+  private:
+    struct BankRefresh
+    {
+        Cycles offset;
+        // Start of the next refresh slot
+        Cycles nextSlot;
+        // Current refresh if refreshing, otherwise the next one; only
+        // known ahead without elastic refresh
+        Cycles windowStart;
+        Cycles windowEnd;
+        bool refreshing;
+        // Refreshes due but not issued, negative when pulled in
+        int owed;
+        // Row of the window above
+        unsigned int row;
+        // Row the next refresh covers
+        unsigned int nextRow;
+        // Times every row of the bank had its turn
+        uint64_t round;
+        // End of the last demand access
+        Cycles busyUntil;
+        Cycles nextEvaluation;
+    };
+
+    // Start of the first slot of the bank that ends after the cycle
+    Cycles nextWindowStart(const BankRefresh &bank, Cycles cycle) const;
+    // Whether a refresh of the bank blocks the set in the cycle, and
+    // its end
+    bool refreshCovering(unsigned int bank, int64_t set, Cycles cycle,
+                         Cycles &end) const;
+    // Row group of a cache set within its bank, and of a row
+    unsigned int setGroup(int64_t set) const;
+    unsigned int rowGroup(unsigned int row) const;
+    // First set index within a bank of the row group
+    int64_t groupStart(unsigned int group) const;
+
+    // Fills the bloom filters of the retention bins for every row
+    void assignBins();
+    // Bin of a row that keeps its data for the given cycles
+    unsigned int retentionBin(uint64_t retention) const;
+    // Refresh period multiple of the bin of the row
+    unsigned int rowMultiplier(unsigned int bank, unsigned int row) const;
+    Addr rowKey(unsigned int bank, unsigned int row) const
+    {
+        return (Addr)bank * m_rows + row;
+    }
+
+    void evaluate(unsigned int bank, Cycles now);
+    // Starts the refresh of the next row, false if it was skipped
+    bool issueRefresh(unsigned int bank, Cycles now);
+    void planEvaluation(unsigned int bank, Cycles cycle);
+    void processRefreshEvent();
+    void scheduleRefreshEvent();
+
+    Cycles m_period;
+    Cycles m_latency;
+    unsigned int m_max_postponed;
+    unsigned int m_max_pulled_in;
+    Cycles m_idle_threshold;
+    unsigned int m_rows;
+    bool m_skip_invalid;
+    bool m_distributed;
+    double m_energy_per_refresh;
+    Cycles m_retention_time;
+    // Multi-rate refresh, shortest retention first; the last multiplier
+    // is for the rows in no bin
+    std::vector<bloom_filter::Base *> m_bins;
+    std::vector<unsigned int> m_bin_multipliers;
+    std::vector<double> m_bin_fractions;
+    std::string m_retention_profile;
+    ExpiryCheck m_expiry_check;
+    unsigned int m_row_groups;
+    int64_t m_sets_per_bank;
+    RubySystem *m_ruby_system;
+
+    std::vector<BankRefresh> m_banks;
+    // Allocated lines in each row group of each bank
+    std::vector<unsigned int> m_valid_lines;
+
+    // Pending evaluations of all banks, earliest first; entries that no
+    // longer match the nextEvaluation of their bank are stale
+    typedef std::pair<Cycles, unsigned int> Transition;
+    std::priority_queue<Transition, std::vector<Transition>,
+                        std::greater<Transition>> m_transitions;
+    EventFunctionWrapper refreshEvent;
+
+    struct RefreshStats : public statistics::Group
+    {
+        RefreshStats(statistics::Group *parent);
+
+        statistics::Scalar refreshes;
+        statistics::Scalar postponed;
+        statistics::Scalar pulledIn;
+        statistics::Scalar forced;
+        statistics::Scalar skipped;
+        statistics::Scalar retentionSkipped;
+        statistics::Scalar expired;
+        statistics::Vector binRows;
+        statistics::Vector bankRefreshes;
+        statistics::Vector bankRefreshCycles;
+        statistics::Scalar energy;
+    } stats;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_STRUCTURES_REFRESHCONTROLLER_HH__
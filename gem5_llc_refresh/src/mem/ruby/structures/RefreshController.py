@@ -0,0 +1,89 @@
+# Copyright (c) 2025 Georgia Institute of Technology
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import SimObject
+
+
+class RubyRefreshController(SimObject):
+    type = "RubyRefreshController"
+    cxx_class = "gem5::ruby::RefreshController"
+    cxx_header = "mem/ruby/structures/RefreshController.hh"
+
+    period = Param.Cycles("cycles from one refresh of a bank to the next")
+    latency = Param.Cycles(
+        "cycles a bank is busy refreshing at the end of each period, "
+        "below the period; 0 disables refresh"
+    )
+    max_postponed = Param.Unsigned(
+        0, "refreshes a bank with recent demand may postpone"
+    )
+    max_pulled_in = Param.Unsigned(
+        0, "refreshes an idle bank may issue ahead of their slots"
+    )
+    idle_threshold = Param.Cycles(
+        16, "cycles without demand after which a bank counts as idle"
+    )
+    retention_time = Param.Cycles(
+        0,
+        "cycles a row keeps its data; bounds the period of elastic "
+        "refresh, unchecked if 0",
+    )
+    rows = Param.Unsigned(
+        1, "refreshes it takes to refresh every row of a bank once"
+    )
+    skip_invalid = Param.Bool(
+        False, "skip the refresh of rows without allocated lines"
+    )
+    distributed = Param.Bool(
+        False,
+        "a refresh only blocks the sets of the row group it refreshes "
+        "instead of the whole bank",
+    )
+    retention_bins = VectorParam.BloomFilterBase(
+        [],
+        "rows of each retention bin for multi-rate refresh, shortest "
+        "retention first; keyed by bank * rows + row, so offset_bits "
+        "should be 0",
+    )
+    bin_multipliers = VectorParam.Unsigned(
+        [],
+        "refresh period of each bin as a multiple of the period, plus a "
+        "last one for the rows in no bin",
+    )
+    bin_fractions = VectorParam.Float(
+        [], "fraction of the rows drawn into each bin, without a profile"
+    )
+    retention_profile = Param.String(
+        "",
+        "per-row retention profile, '<bank> <row> <retention cycles>' "
+        "lines; rows it misses are in the first bin",
+    )
+    energy_per_refresh = Param.Float(
+        0.0, "energy (J) of one bank refresh, for the energy stat"
+    )
+    ruby_system = Param.RubySystem(Parent.any, "")
@@ -54,4 +54,25 @@ class RubyCache(SimObject):
     dataAccessLatency = Param.Cycles(1, "cycles for a data array access")
     tagAccessLatency = Param.Cycles(1, "cycles for a tag array access")
     resourceStalls = Param.Bool(False, "stall if there is a resource failure")
+    refresh_schedule = Param.String(
+        "",
+        "NS-Cache refresh schedule with the per-bank refresh offsets; "
+        "every bank starts refreshing at cycle 0 if empty",
+    )
+    data_refresh = Param.RubyRefreshController(
+        NULL, "refresh of the data array banks, none if NULL"
+    )
+    tag_refresh = Param.RubyRefreshController(
+        NULL, "refresh of the tag array banks, none if NULL"
+    )
+    dead_block_predictor = Param.RubyDeadBlockPredictor(
+        NULL,
+        "lets data array rows whose lines are predicted dead expire "
+        "instead of being refreshed, none if NULL",
+    )
+    expired_line_queue = Param.MessageBuffer(
+        NULL,
+        "queue of the controller the lines that expire as predicted dead "
+        "are replaced from; needed with a dead-block predictor",
+    )
     ruby_system = Param.RubySystem(Parent.any, "")
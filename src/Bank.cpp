@@ -18,11 +18,24 @@
 
 
 #include "Bank.h"
+#include "formula.h"
+#include "global.h"
+
+#include <math.h>
 
 Bank::Bank() {
 	// TODO Auto-generated constructor stub
 	initialized = false;
 	invalid = false;
+	numConcurrentRefreshSubArray = numRefreshStep = 1;
+	refreshPeakPower = 0;
+	numRowSlice = numColumnSlice = 0;
+	maxRoutingSegmentLatency = 0;
+	for (int i = 0; i < (int)num_pipeline_stages; i++)
+		readStageLatency[i] = 0;
+	numIndependentGroup = 1;
+	tsvState = TSVState();
+	tsvLocalWireType = tsvGlobalWireType = 0;
 }
 
 Bank::~Bank() {
@@ -75,6 +88,9 @@ Bank & Bank::operator=(const Bank &rhs) {
 	numActiveMatPerColumn = rhs.numActiveMatPerColumn;
     stackedDieCount = rhs.stackedDieCount;
     partitionGranularity = rhs.partitionGranularity;
+    tsvState = rhs.tsvState;
+    tsvLocalWireType = rhs.tsvLocalWireType;
+    tsvGlobalWireType = rhs.tsvGlobalWireType;
     routingReadLatency = rhs.routingReadLatency;
     routingWriteLatency = rhs.routingWriteLatency;
     routingResetLatency = rhs.routingResetLatency;
@@ -86,7 +102,63 @@ Bank & Bank::operator=(const Bank &rhs) {
     routingSetDynamicEnergy = rhs.routingSetDynamicEnergy;
     routingRefreshDynamicEnergy = rhs.routingRefreshDynamicEnergy;
     routingLeakage = rhs.routingLeakage;
+	numConcurrentRefreshSubArray = rhs.numConcurrentRefreshSubArray;
+	numRefreshStep = rhs.numRefreshStep;
+	refreshPeakPower = rhs.refreshPeakPower;
+	numRowSlice = rhs.numRowSlice;
+	numColumnSlice = rhs.numColumnSlice;
+	sliceReadLatency = rhs.sliceReadLatency;
+	sliceWriteLatency = rhs.sliceWriteLatency;
+	maxRoutingSegmentLatency = rhs.maxRoutingSegmentLatency;
+	for (int i = 0; i < (int)num_pipeline_stages; i++)
+		readStageLatency[i] = rhs.readStageLatency[i];
+	numIndependentGroup = rhs.numIndependentGroup;
 	subarray = rhs.subarray;
     tsvArray = rhs.tsvArray;
 	return *this;
 }
+
+void Bank::CalculateRefreshConcurrency() {
+	/* subarray must have its latency and power calculated */
+	int numSubArray = numRowSubArray * numColumnSubArray;
+	double subarrayRefreshPower = 0;
+	if (subarray.refreshLatency > 0)
+		subarrayRefreshPower = subarray.refreshDynamicEnergy / subarray.refreshLatency;
+
+	if (inputParameter->refreshPowerBudget > 0 && subarrayRefreshPower > 0) {
+		numConcurrentRefreshSubArray = (int)MIN(floor(inputParameter->refreshPowerBudget / subarrayRefreshPower), (double)numSubArray);
+		if (numConcurrentRefreshSubArray < 1) {
+			/* Even a single subarray exceeds the budget */
+			invalid = true;
+			numConcurrentRefreshSubArray = 1;
+		}
+	} else {
+		/* Legacy model: one column of subarrays refreshes at a time */
+		numConcurrentRefreshSubArray = numRowSubArray;
+	}
+	numRefreshStep = (numSubArray + numConcurrentRefreshSubArray - 1) / numConcurrentRefreshSubArray;
+	refreshPeakPower = subarrayRefreshPower * numConcurrentRefreshSubArray;
+}
+
+void Bank::CalculatePipeline() {
+	/* subarray and routing must have their latency calculated */
+	const Mat &mat = subarray.mat;
+	double rowDecoderLatency = (cell->memCellType == gcDRAM) ? mat.gcRowDecoder.readLatency : mat.rowDecoder.readLatency;
+	double decoderLatency = MAX(rowDecoderLatency, mat.columnDecoderLatency);
+	double muxLatency = mat.senseAmpMuxLev1.readLatency + mat.senseAmpMuxLev2.readLatency;
+	readStageLatency[predecode_stage] = subarray.predecoderLatency;
+	readStageLatency[decode_stage] = decoderLatency;
+	/* The rest of the mat read, including the repeated decoder wires, keeps the bitlines busy */
+	readStageLatency[bitline_stage] = MAX(mat.readLatency - decoderLatency - muxLatency, 0);
+	readStageLatency[mux_stage] = muxLatency;
+	readStageLatency[compare_stage] = MAX(subarray.readLatency - subarray.predecoderLatency - mat.readLatency, 0);
+	/* Requests and data travel on separate wires, so the routing is one stage each way */
+	if (inputParameter->pipelineLatches && inputParameter->routingMode == h_tree)
+		readStageLatency[routing_stage] = maxRoutingSegmentLatency;
+	else
+		readStageLatency[routing_stage] = routingReadLatency / 2;
+	readStageLatency[tsv_stage] = 0;
+	if (stackedDieCount > 1)
+		readStageLatency[tsv_stage] = (stackedDieCount - 1) * MAX(tsvArray.readLatency, tsvArray.writeLatency);
+	numIndependentGroup = MAX(numRowSubArray * numColumnSubArray / (numActiveSubArrayPerRow * numActiveSubArrayPerColumn), 1);
+}
@@ -25,6 +25,8 @@
 #include "typedef.h"
 #include "TSV.h"
 
+#include <vector>
+
 class Bank: public FunctionUnit {
 public:
 	Bank();
@@ -43,6 +45,8 @@ public:
 	virtual void CalculateRC() = 0;
 	virtual void CalculateLatencyAndPower() = 0;
 	virtual Bank & operator=(const Bank &);
+	void CalculateRefreshConcurrency();	/* Decide how many subarrays refresh at the same time */
+	void CalculatePipeline();	/* Split a read into the stages of PipelineStage */
 
 	/* Properties */
 	bool initialized;	/* Initialization flag */
@@ -67,6 +71,9 @@ public:
 	MemoryType memoryType;
     int stackedDieCount;
     int partitionGranularity;
+    TSVState tsvState;			/* The TSV parameters of tech when the bank was initialized */
+    int tsvLocalWireType;		/* inputParameter->maxLocalWireType when the bank was initialized, it picks the TSV type */
+    int tsvGlobalWireType;		/* inputParameter->maxGlobalWireType when the bank was initialized, it picks the TSV type */
     double routingReadLatency;
     double routingWriteLatency;
     double routingResetLatency;
@@ -78,6 +85,16 @@ public:
     double routingSetDynamicEnergy; /* Non-TSV routing energy. */
     double routingRefreshDynamicEnergy; /* Non-TSV routing energy. */
     double routingLeakage;
+	int numConcurrentRefreshSubArray;	/* Subarrays refreshing at the same time under the refresh power budget */
+	int numRefreshStep;			/* Serialized refresh rounds needed to cover all the subarrays */
+	double refreshPeakPower;	/* Refresh power of the concurrently refreshing subarrays, Unit: W */
+	int numRowSlice;			/* Non-uniform cache slices along the bank height, 0 if not sliced */
+	int numColumnSlice;			/* Non-uniform cache slices along the bank width, 0 if not sliced */
+	vector<double> sliceReadLatency;	/* Read latency of each slice, row by row, Unit: s */
+	vector<double> sliceWriteLatency;	/* Write latency of each slice, row by row, Unit: s */
+	double maxRoutingSegmentLatency;	/* Slowest routing wire between two latch points, one way, Unit: s */
+	double readStageLatency[num_pipeline_stages];	/* Unit: s */
+	int numIndependentGroup;	/* Groups of subarrays that serve different reads at the same time */
 
 	SubArray subarray;
     TSV tsvArray;
@@ -169,6 +169,9 @@ void BankWithHtree::Initialize(int _numRowSubArray, int _numColumnSubArray, long
 	memoryType = _memoryType;
     stackedDieCount = _stackedDieCount;
     partitionGranularity = _partitionGranularity;
+    tsvState = tech->GetTSVState();
+    tsvLocalWireType = inputParameter->maxLocalWireType;
+    tsvGlobalWireType = inputParameter->maxGlobalWireType;
 	int numWay = 1;	/* default value for non-cache design */
 
 	/* Calculate the physical signals that are required in routing. Use double during the calculation to avoid overflow */
@@ -643,7 +646,8 @@ void BankWithHtree::CalculateLatencyAndPower() {
 		//readLatency = 1/(((subarray.numRowMat * subarray.numColumnMat * subarray.mat.numColumn) /  subarray.mat.readLatency) / area);
 		//writeLatency = ((subarray.numRowMat * subarray.numColumnMat * subarray.mat.numColumn) /  subarray.mat.writeLatency) / area;
 		//writeLatency = (0.5 * subarray.mat.readLatency + 0.5 * subarray.mat.readLatency_bidir)/2;
-        refreshLatency = subarray.refreshLatency * numColumnSubArray; // TOTAL refresh time for all SubArrays
+        CalculateRefreshConcurrency();
+        refreshLatency = subarray.refreshLatency * numRefreshStep; // TOTAL refresh time for all SubArrays
 		readDynamicEnergy = subarray.readDynamicEnergy * numActiveSubArrayPerRow * numActiveSubArrayPerColumn;
 		writeDynamicEnergy = subarray.writeDynamicEnergy * numActiveSubArrayPerRow * numActiveSubArrayPerColumn;
         refreshDynamicEnergy = subarray.refreshDynamicEnergy * numRowSubArray * numColumnSubArray;
@@ -663,8 +667,10 @@ void BankWithHtree::CalculateLatencyAndPower() {
 		if (inputParameter->designTarget == cache && inputParameter->cacheAccessMode == fast_access_mode)
 			beta = inputParameter->associativity;
 
+		maxRoutingSegmentLatency = 0;
 		for (int i = 0; i < levelHorizontal; i++) {
 			globalWire->CalculateLatencyAndPower(lengthHorizontalWire[i], &latency, &energy, &leakageWire);
+			maxRoutingSegmentLatency = MAX(maxRoutingSegmentLatency, latency);
 			readLatency += latency * 2;						/* 2 due to in/out */
 			writeLatency += latency;						/* only in */
 			resetLatency += latency;
@@ -686,6 +692,7 @@ void BankWithHtree::CalculateLatencyAndPower() {
 		}
 		for (int i = 0; i < levelVertical; i++) {
 			globalWire->CalculateLatencyAndPower(lengthVerticalWire[i], &latency, &energy, &leakageWire);
+			maxRoutingSegmentLatency = MAX(maxRoutingSegmentLatency, latency);
 			readLatency += latency * 2;						/* 2 due to in/out */
 			writeLatency += latency;						/* only in */
 			resetLatency += latency;
@@ -770,6 +777,10 @@ void BankWithHtree::CalculateLatencyAndPower() {
 
             leakage += tsvArray.numTotalBits * (stackedDieCount-1) * tsvArray.leakage;
         }
+
+		CalculatePipeline();
+		if (inputParameter->nucaSlices > 0)
+			CalculateSliceLatency();
 	}
 
     if (cell->memCellType == eDRAM || cell->memCellType == gcDRAM) {
@@ -779,6 +790,54 @@ void BankWithHtree::CalculateLatencyAndPower() {
     }
 }
 
+/* Splits the bank into -NucaSlices slices, each a self-contained sub-bank at the leaves of the H-tree. */
+/* A slice keeps the H-tree levels below its own root and reaches the bank root over a global wire as long */
+/* as its Manhattan distance, so the slices near the center of the bank are served faster than the */
+/* worst-case latency of the uniform bank. A single slice gives back the bank latency. */
+void BankWithHtree::CalculateSliceLatency() {
+	sliceReadLatency.clear();
+	sliceWriteLatency.clear();
+	numRowSlice = numColumnSlice = 1;
+	while (numRowSlice * numColumnSlice < inputParameter->nucaSlices) {
+		/* Halve the slices along the dimension with more subarrays left in each */
+		int numColumnLeft = numColumnSubArray / numColumnSlice;
+		int numRowLeft = numRowSubArray / numRowSlice;
+		if (numColumnLeft > 1 && numColumnLeft >= numRowLeft) {
+			numColumnSlice *= 2;
+		} else if (numRowLeft > 1) {
+			numRowSlice *= 2;
+		} else {
+			/* Fewer subarrays than slices */
+			numRowSlice = numColumnSlice = 0;
+			return;
+		}
+	}
+
+	double latency, energy, leakageWire;
+	double localLatency = 0;	/* One way through the H-tree of a slice */
+	for (int i = (int)(log2(numColumnSlice) + 0.1); i < levelHorizontal; i++) {
+		globalWire->CalculateLatencyAndPower(lengthHorizontalWire[i], &latency, &energy, &leakageWire);
+		localLatency += latency;
+	}
+	for (int i = (int)(log2(numRowSlice) + 0.1); i < levelVertical; i++) {
+		globalWire->CalculateLatencyAndPower(lengthVerticalWire[i], &latency, &energy, &leakageWire);
+		localLatency += latency;
+	}
+
+	/* routingWriteLatency is the one-way H-tree latency of the whole bank */
+	for (int row = 0; row < numRowSlice; row++) {
+		for (int column = 0; column < numColumnSlice; column++) {
+			double distance = fabs((column + 0.5) * width / numColumnSlice - width / 2)
+					+ fabs((row + 0.5) * height / numRowSlice - height / 2);
+			double routeLatency = 0;
+			if (distance > 0)
+				globalWire->CalculateLatencyAndPower(distance, &routeLatency, &energy, &leakageWire);
+			sliceReadLatency.push_back(readLatency + 2 * (localLatency + routeLatency - routingWriteLatency));
+			sliceWriteLatency.push_back(writeLatency + localLatency + routeLatency - routingWriteLatency);
+		}
+	}
+}
+
 BankWithHtree & BankWithHtree::operator=(const BankWithHtree &rhs) {
 	//cout << "[PROGRESS] Line 747 :: BankWithHtree.cc" << endl;
 	Bank::operator=(rhs);
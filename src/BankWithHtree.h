@@ -36,6 +36,7 @@ public:
 	void CalculateArea();
 	void CalculateRC();
 	void CalculateLatencyAndPower();
+	void CalculateSliceLatency();	/* Distance-dependent latency of the -NucaSlices slices */
 	BankWithHtree & operator=(const BankWithHtree &);
 
 	int numAddressBit;		/* Number of bank address bits */
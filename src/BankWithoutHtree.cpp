@@ -69,6 +69,9 @@ void BankWithoutHtree::Initialize(int _numRowSubArray, int _numColumnSubArray, l
 	memoryType = _memoryType;
     stackedDieCount = _stackedDieCount;
     partitionGranularity = _partitionGranularity;
+    tsvState = tech->GetTSVState();
+    tsvLocalWireType = inputParameter->maxLocalWireType;
+    tsvGlobalWireType = inputParameter->maxGlobalWireType;
 	numWay = 1;	/* default value for non-cache design */
 
 	/* Calculate the physical signals that are required in routing. Use double during the calculation to avoid overflow */
@@ -331,7 +334,8 @@ void BankWithoutHtree::CalculateLatencyAndPower() {
 		subarray.CalculateLatency(infinite_ramp);
 		subarray.CalculatePower();
 		readLatency = resetLatency = setLatency = writeLatency = 0;
-        refreshLatency = subarray.refreshLatency * numColumnSubArray; // TOTAL refresh time for all SubArrays
+        CalculateRefreshConcurrency();
+        refreshLatency = subarray.refreshLatency * numRefreshStep; // TOTAL refresh time for all SubArrays
 		readDynamicEnergy = writeDynamicEnergy = resetDynamicEnergy = setDynamicEnergy = 0;
         refreshDynamicEnergy = subarray.refreshDynamicEnergy * numRowSubArray * numColumnSubArray;
 		leakage = 0;
@@ -549,6 +553,10 @@ void BankWithoutHtree::CalculateLatencyAndPower() {
         leakage += tsvArray.numTotalBits * (stackedDieCount-1) * tsvArray.leakage;
     }
 
+    /* The bus has no latch points, it is a single routing stage */
+    if (initialized && !invalid)
+        CalculatePipeline();
+
     if (cell->memCellType == eDRAM || cell->memCellType == gcDRAM) {
         if (refreshLatency > cell->retentionTime) {
             invalid = true;
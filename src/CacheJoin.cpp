@@ -0,0 +1,212 @@
+/*******************************************************************************
+* Copyright (c) 2025
+* Georgia Institute of Technology
+*
+* This source code is part of NeuroSim (NS)-Cache - a framework developed for early
+* exploration of cache memories in advanced technology nodes (FinFET, nanosheet, CFET generations).
+* The tool extends previously developed Destiny, NVSim, and Cacti3dd. (Copyright Information Below)
+* Copyright of the model is maintained by the developers, and the model is distributed under
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License (see LICENSE)
+*******************************************************************************/
+
+
+#include "CacheJoin.h"
+#include "global.h"
+#include "formula.h"
+#include "macros.h"
+
+#include <iostream>
+#include <algorithm>
+
+static const char *objectiveName[num_cache_objectives] = {"Hit Latency", "Miss Latency", "Write Latency", "Hit EDP"};
+
+/* Copies the design and wires, Result has no copy constructor of its own */
+static void CopyResult(Result *target, const Result &source) {
+	*(target->bank) = *(source.bank);
+	*(target->localWire) = *(source.localWire);
+	*(target->globalWire) = *(source.globalWire);
+	target->cellTech = cell;
+}
+
+CacheJoin::CacheJoin() {
+	numJoined = 0;
+	levelTags = false;
+	fastestWriteTag = -1;
+	for (int i = 0; i < (int)num_cache_objectives; i++) {
+		bestData[i] = new Result();
+		bestTag[i] = new Result();
+		for (int j = 0; j < (int)num_cache_objectives; j++)
+			bestMetric[i][j] = invalid_value;
+	}
+}
+
+CacheJoin::~CacheJoin() {
+	// TODO Auto-generated destructor stub
+	ClearTags();
+	for (int i = 0; i < (int)num_cache_objectives; i++) {
+		delete bestData[i];
+		delete bestTag[i];
+	}
+}
+
+void CacheJoin::ClearTags() {
+	for (int i = 0; i < (int)tags.size(); i++)
+		delete tags[i];
+	tags.clear();
+	energyStairs.clear();
+	fastestWriteTag = -1;
+	numJoined = 0;
+}
+
+/* kept is at least as fast to read and write and as cheap to read as candidate, and under levelTags */
+/* no worse in the rest of what a hierarchy level charges for its tag either */
+bool CacheJoin::TagCovers(const Bank *kept, const Bank *candidate) const {
+	if (kept->readLatency > candidate->readLatency || kept->readDynamicEnergy > candidate->readDynamicEnergy
+			|| kept->writeLatency > candidate->writeLatency)
+		return false;
+	return !levelTags || (kept->writeDynamicEnergy <= candidate->writeDynamicEnergy && kept->leakage <= candidate->leakage
+			&& kept->area <= candidate->area && REFRESH_POWER(cell, kept) <= REFRESH_POWER(cell, candidate));
+}
+
+/* Keeps the tag design unless one already kept covers it */
+void CacheJoin::InsertTag(const Result &tagResult) {
+	const Bank *candidate = tagResult.bank;
+	for (int i = 0; i < (int)tags.size(); i++)
+		if (TagCovers(tags[i]->bank, candidate))
+			return;
+	int numKept = 0;
+	for (int i = 0; i < (int)tags.size(); i++) {
+		if (TagCovers(candidate, tags[i]->bank))
+			delete tags[i];
+		else
+			tags[numKept++] = tags[i];
+	}
+	tags.resize(numKept);
+	Result *copy = new Result();
+	CopyResult(copy, tagResult);
+	tags.push_back(copy);
+}
+
+/* Sorts the frontier for Join, once the tag search of the cell is over */
+void CacheJoin::FinishTags() {
+	sort(tags.begin(), tags.end(), [](const Result *x, const Result *y) {
+		if (x->bank->readLatency != y->bank->readLatency)
+			return x->bank->readLatency < y->bank->readLatency;
+		return x->bank->readDynamicEnergy < y->bank->readDynamicEnergy;
+	});
+	energyStairs.clear();
+	fastestWriteTag = -1;
+	for (int i = 0; i < (int)tags.size(); i++) {
+		if (energyStairs.empty() || tags[i]->bank->readDynamicEnergy < tags[energyStairs.back()]->bank->readDynamicEnergy)
+			energyStairs.push_back(i);
+		if (fastestWriteTag < 0 || tags[i]->bank->writeLatency < tags[fastestWriteTag]->bank->writeLatency)
+			fastestWriteTag = i;
+	}
+}
+
+/* Same model as Result::printAsCache; the hit energy is the read energy of both arrays in every access mode */
+void CacheJoin::getCacheMetrics(const Bank *dataBank, const Bank *tagBank, double metric[num_cache_objectives]) {
+	double latencies[3];	/* hit, miss, write */
+	Result::getAccessLatencies(dataBank, tagBank, latencies);
+	metric[cache_hit_latency] = latencies[0];
+	metric[cache_miss_latency] = latencies[1];
+	metric[cache_write_latency] = latencies[2];
+	metric[cache_edp] = latencies[0] * (tagBank->readDynamicEnergy + dataBank->readDynamicEnergy);
+}
+
+/* The cache objective an array-level target stands for, num_cache_objectives if there is none */
+CacheObjective CacheJoin::getObjective(OptimizationTarget target) {
+	switch (target) {
+	case read_latency_optimized:
+		return cache_hit_latency;
+	case write_latency_optimized:
+		return cache_write_latency;
+	case read_edp_optimized:
+		return cache_edp;
+	default:
+		return num_cache_objectives;
+	}
+}
+
+/* Ties go to the faster hit, or to the lower EDP when the hit latency itself is the objective */
+void CacheJoin::Update(CacheObjective objective, const Result &dataResult, const Result *tagResult) {
+	double metric[num_cache_objectives];
+	getCacheMetrics(dataResult.bank, tagResult->bank, metric);
+	CacheObjective tieBreak = (objective == cache_hit_latency) ? cache_edp : cache_hit_latency;
+	const double *best = bestMetric[objective];
+	if (metric[objective] < best[objective] || (metric[objective] == best[objective] && metric[tieBreak] < best[tieBreak])) {
+		CopyResult(bestData[objective], dataResult);
+		CopyResult(bestTag[objective], *tagResult);
+		for (int i = 0; i < (int)num_cache_objectives; i++)
+			bestMetric[objective][i] = metric[i];
+	}
+}
+
+/* Every cache latency only grows with the tag latencies, so the hit and miss latencies take the fastest */
+/* reading tag and the write latency the fastest writing one. The hit EDP trades the tag read latency */
+/* against its energy: tags up to the data latency they hide behind cost nothing in latency, so only */
+/* the cheapest of them counts, and past that only the energy stairs can win. */
+void CacheJoin::Join(const Result &dataResult) {
+	if (tags.empty())
+		return;
+	numJoined++;
+	Update(cache_hit_latency, dataResult, tags[0]);
+	Update(cache_miss_latency, dataResult, tags[0]);
+	Update(cache_write_latency, dataResult, tags[fastestWriteTag]);
+
+	/* hit latency = MAX(tag read latency, hidden) + the rest */
+	const Bank *dataBank = dataResult.bank;
+	double hidden;
+	if (inputParameter->cacheAccessMode == normal_access_mode)
+		hidden = dataBank->subarray.readLatency;
+	else if (inputParameter->cacheAccessMode == fast_access_mode)
+		hidden = dataBank->readLatency;
+	else	/* sequential access */
+		hidden = 0;
+	int first = upper_bound(energyStairs.begin(), energyStairs.end(), hidden,
+			[this](double latency, int stair) { return latency < tags[stair]->bank->readLatency; }) - energyStairs.begin();
+	first = MAX(first - 1, 0);
+	int bestStair = energyStairs[first];
+	double metric[num_cache_objectives], bestEdp = invalid_value;
+	for (int i = first; i < (int)energyStairs.size(); i++) {
+		getCacheMetrics(dataBank, tags[energyStairs[i]]->bank, metric);
+		if (metric[cache_edp] < bestEdp) {
+			bestEdp = metric[cache_edp];
+			bestStair = energyStairs[i];
+		}
+	}
+	Update(cache_edp, dataResult, tags[bestStair]);
+}
+
+/* independentData and independentTag are the per-target optima, as the rest of the output pairs them */
+void CacheJoin::Print(Result *independentData, Result *independentTag) {
+	static const OptimizationTarget independentTarget[num_cache_objectives] =
+			{read_latency_optimized, read_latency_optimized, write_latency_optimized, read_edp_optimized};
+
+	cout << endl << "=============================" << endl << "CACHE-LEVEL OPTIMA -- SUMMARY" << endl << "=============================" << endl;
+	cout << "Tag and data arrays are paired under the cache access model instead of being optimized one at a time" << endl;
+	for (int i = 0; i < (int)num_cache_objectives; i++) {
+		const double *metric = bestMetric[i];
+		cout << objectiveName[i] << " Optimum:" << endl;
+		if (metric[i] >= invalid_value) {
+			cout << " - No valid pair" << endl;
+			continue;
+		}
+		double independent[num_cache_objectives];
+		getCacheMetrics(independentData[independentTarget[i]].bank, independentTag[independentTarget[i]].bank, independent);
+		cout << " - Cache Hit Latency   = " << TO_SECOND(metric[cache_hit_latency]) << endl;
+		cout << " - Cache Miss Latency  = " << TO_SECOND(metric[cache_miss_latency]) << endl;
+		cout << " - Cache Write Latency = " << TO_SECOND(metric[cache_write_latency]) << endl;
+		cout << " - Cache Hit EDP       = " << scientific << metric[cache_edp] << fixed << "s-J" << endl;
+		cout << " - Independent Arrays  = ";
+		if (i == cache_edp)
+			cout << scientific << independent[i] << fixed << "s-J";
+		else
+			cout << TO_SECOND(independent[i]);
+		cout << " (" << (independent[i] - metric[i]) / independent[i] * 100 << "% improved)" << endl;
+		cout << " - Data Array = Bank " << bestData[i]->bank->numRowSubArray << "x" << bestData[i]->bank->numColumnSubArray
+				<< " SubArrays, SubArray " << bestData[i]->bank->numRowMat << "x" << bestData[i]->bank->numColumnMat << " Mats" << endl;
+		cout << " - Tag Array  = Bank " << bestTag[i]->bank->numRowSubArray << "x" << bestTag[i]->bank->numColumnSubArray
+				<< " SubArrays, SubArray " << bestTag[i]->bank->numRowMat << "x" << bestTag[i]->bank->numColumnMat << " Mats" << endl;
+	}
+}
@@ -0,0 +1,71 @@
+/*******************************************************************************
+* Copyright (c) 2025
+* Georgia Institute of Technology
+*
+* This source code is part of NeuroSim (NS)-Cache - a framework developed for early
+* exploration of cache memories in advanced technology nodes (FinFET, nanosheet, CFET generations).
+* The tool extends previously developed Destiny, NVSim, and Cacti3dd. (Copyright Information Below)
+* Copyright of the model is maintained by the developers, and the model is distributed under
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License (see LICENSE)
+*******************************************************************************/
+
+
+#ifndef CACHEJOIN_H_
+#define CACHEJOIN_H_
+
+#include <vector>
+
+#include "Result.h"
+
+using namespace std;
+
+enum CacheObjective
+{
+	cache_hit_latency,			/* Unit: s */
+	cache_miss_latency,			/* Unit: s */
+	cache_write_latency,		/* Unit: s */
+	cache_edp,					/* Hit latency * hit dynamic energy, Unit: s-J */
+	num_cache_objectives
+};
+
+/* Cache-level optima over pairs of tag and data designs, under the -CacheAccessMode latency and energy */
+/* model of Result::printAsCache. The tag designs of a cell are kept as a Pareto frontier sorted by read */
+/* latency, every data design is then paired with the best tag of each objective as it is evaluated. */
+/* A hierarchy level also keeps the tags that save write energy, leakage, area, or refresh power, and */
+/* pairs every data design with all of them. */
+class CacheJoin {
+public:
+	CacheJoin();
+	virtual ~CacheJoin();
+
+	/* Functions */
+	void ClearTags();
+	void InsertTag(const Result &tagResult);
+	void FinishTags();
+	void Join(const Result &dataResult);
+	const vector<Result *> &getTags() const { return tags; }
+	Result *getData(CacheObjective objective) { return bestData[objective]; }
+	Result *getTag(CacheObjective objective) { return bestTag[objective]; }
+	static void getCacheMetrics(const Bank *dataBank, const Bank *tagBank, double metric[num_cache_objectives]);
+	static CacheObjective getObjective(OptimizationTarget target);
+	void Print(Result *independentData, Result *independentTag);
+
+	/* Properties */
+	long long numJoined;		/* Data designs paired this cell */
+	bool levelTags;				/* Keep the tags of a hierarchy level's Pareto frontier as well */
+
+private:
+	void Update(CacheObjective objective, const Result &dataResult, const Result *tagResult);
+
+	bool TagCovers(const Bank *kept, const Bank *candidate) const;
+
+	vector<Result *> tags;		/* Non-dominated in read latency, read energy, and write latency (and the level */
+								/* metrics under levelTags); by read latency */
+	vector<int> energyStairs;	/* Into tags, strictly falling read energy as read latency rises */
+	int fastestWriteTag;		/* Into tags */
+	Result *bestData[num_cache_objectives];
+	Result *bestTag[num_cache_objectives];
+	double bestMetric[num_cache_objectives][num_cache_objectives];	/* All the metrics of each optimum */
+};
+
+#endif /* CACHEJOIN_H_ */
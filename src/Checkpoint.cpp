@@ -0,0 +1,306 @@
+/*******************************************************************************
+* Copyright (c) 2025
+* Georgia Institute of Technology
+* 
+* This source code is part of NeuroSim (NS)-Cache - a framework developed for early
+* exploration of cache memories in advanced technology nodes (FinFET, nanosheet, CFET generations).
+* The tool extends previously developed Destiny, NVSim, and Cacti3dd. (Copyright Information Below)
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License (see LICENSE)
+*******************************************************************************/
+
+
+#include "Checkpoint.h"
+#include "global.h"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* 64-bit FNV-1a, stable across builds unlike std::hash */
+static unsigned long long HashFile(const string &fileName, unsigned long long hash) {
+	ifstream file(fileName.c_str(), ifstream::binary);
+	char c;
+	while (file.get(c)) {
+		hash ^= (unsigned char)c;
+		hash *= 1099511628211ULL;
+	}
+	/* Tell a missing file from an empty one */
+	hash ^= file.is_open() ? 1 : 2;
+	hash *= 1099511628211ULL;
+	return hash;
+}
+
+static void StoreResult(Result &result, CheckpointResult &saved) {
+	Bank *bank = result.bank;
+	saved.hasDesign = (bank->area < invalid_value);
+	if (saved.hasDesign) {
+		saved.design = DesignKey(bank->capacity, bank->blockSize, bank->associativity, bank->numRowSubArray,
+				bank->numColumnSubArray, bank->stackedDieCount, bank->numActiveSubArrayPerRow, bank->numActiveSubArrayPerColumn,
+				bank->numRowMat, bank->numColumnMat, bank->numActiveMatPerRow, bank->numActiveMatPerColumn,
+				bank->muxSenseAmp, bank->muxOutputLev1, bank->muxOutputLev2, bank->numRowPerSet,
+				(int)bank->areaOptimizationLevel, bank->memoryType);
+		saved.localWireType = result.localWire->wireType;
+		saved.localWireRepeaterType = result.localWire->wireRepeaterType;
+		saved.isLocalWireLowSwing = result.localWire->isLowSwing;
+		saved.globalWireType = result.globalWire->wireType;
+		saved.globalWireRepeaterType = result.globalWire->wireRepeaterType;
+		saved.isGlobalWireLowSwing = result.globalWire->isLowSwing;
+		saved.tsvState = bank->tsvState;
+		saved.tsvLocalWireType = bank->tsvLocalWireType;
+		saved.tsvGlobalWireType = bank->tsvGlobalWireType;
+	}
+	saved.limit[0] = result.limitReadLatency;
+	saved.limit[1] = result.limitWriteLatency;
+	saved.limit[2] = result.limitReadDynamicEnergy;
+	saved.limit[3] = result.limitWriteDynamicEnergy;
+	saved.limit[4] = result.limitReadEdp;
+	saved.limit[5] = result.limitWriteEdp;
+	saved.limit[6] = result.limitReadBandwidth;
+	saved.limit[7] = result.limitWriteBandwidth;
+	saved.limit[8] = result.limitArea;
+	saved.limit[9] = result.limitLeakage;
+	saved.limit[10] = result.limitRefreshBusyRatio;
+	saved.limit[11] = result.limitRefreshPower;
+}
+
+static void RestoreResult(const CheckpointResult &saved, Result &result) {
+	result.reset();
+	result.limitReadLatency = saved.limit[0];
+	result.limitWriteLatency = saved.limit[1];
+	result.limitReadDynamicEnergy = saved.limit[2];
+	result.limitWriteDynamicEnergy = saved.limit[3];
+	result.limitReadEdp = saved.limit[4];
+	result.limitWriteEdp = saved.limit[5];
+	result.limitReadBandwidth = saved.limit[6];
+	result.limitWriteBandwidth = saved.limit[7];
+	result.limitArea = saved.limit[8];
+	result.limitLeakage = saved.limit[9];
+	result.limitRefreshBusyRatio = saved.limit[10];
+	result.limitRefreshPower = saved.limit[11];
+	if (!saved.hasDesign)
+		return;
+
+	/* Re-evaluate the design under the wires and TSV parameters it was found with. These depend on */
+	/* the layer count and wire ranges of the search phase it was found in, not only on the design. */
+	const DesignKey &design = saved.design;
+	TSVState tsvState = tech->GetTSVState();
+	int maxLocalWireType = inputParameter->maxLocalWireType;
+	int maxGlobalWireType = inputParameter->maxGlobalWireType;
+	tech->SetTSVState(saved.tsvState);
+	inputParameter->maxLocalWireType = saved.tsvLocalWireType;
+	inputParameter->maxGlobalWireType = saved.tsvGlobalWireType;
+	localWire->Initialize(inputParameter->processNode, (WireType)saved.localWireType,
+			(WireRepeaterType)saved.localWireRepeaterType, inputParameter->temperature, (bool)saved.isLocalWireLowSwing);
+	globalWire->Initialize(inputParameter->processNode, (WireType)saved.globalWireType,
+			(WireRepeaterType)saved.globalWireRepeaterType, inputParameter->temperature, (bool)saved.isGlobalWireLowSwing);
+	Bank *bank;
+	if (inputParameter->routingMode == h_tree)
+		bank = new BankWithHtree();
+	else
+		bank = new BankWithoutHtree();
+	bank->Initialize(design.numRowSubArray, design.numColumnSubArray, design.capacity, design.blockSize, design.associativity,
+			design.numRowPerSet, design.numActiveSubArrayPerRow, design.numActiveSubArrayPerColumn, design.muxSenseAmp,
+			inputParameter->internalSensing, design.muxOutputLev1, design.muxOutputLev2, design.numRowMat, design.numColumnMat,
+			design.numActiveMatPerRow, design.numActiveMatPerColumn, (BufferDesignTarget)design.areaOptimizationLevel,
+			design.memoryType, design.stackedDieCount, inputParameter->partitionGranularity, inputParameter->monolithicStackCount);
+	bank->CalculateArea();
+	bank->CalculateRC();
+	bank->CalculateLatencyAndPower();
+	*(result.bank) = *bank;
+	*(result.localWire) = *localWire;
+	*(result.globalWire) = *globalWire;
+	delete bank;
+	tech->SetTSVState(tsvState);
+	inputParameter->maxLocalWireType = maxLocalWireType;
+	inputParameter->maxGlobalWireType = maxGlobalWireType;
+}
+
+static void WriteTSVState(ofstream &file, const TSVState &state) {
+	file << " " << state.layerCount;
+	for (int i = 0; i < NUM_TSV_TYPES; i++)
+		file << " " << state.capTSV[i] << " " << state.resTSV[i] << " " << state.areaTSV[i];
+}
+
+static void ReadTSVState(ifstream &file, TSVState &state) {
+	file >> state.layerCount;
+	for (int i = 0; i < NUM_TSV_TYPES; i++)
+		file >> state.capTSV[i] >> state.resTSV[i] >> state.areaTSV[i];
+}
+
+static void WriteResult(ofstream &file, const char *label, int idx, const CheckpointResult &saved) {
+	const DesignKey &design = saved.design;
+	file << label << " " << idx << " " << saved.hasDesign;
+	if (saved.hasDesign) {
+		file << " " << design.capacity << " " << design.blockSize << " " << design.associativity
+				<< " " << design.numRowSubArray << " " << design.numColumnSubArray << " " << design.stackedDieCount
+				<< " " << design.numActiveSubArrayPerRow << " " << design.numActiveSubArrayPerColumn
+				<< " " << design.numRowMat << " " << design.numColumnMat
+				<< " " << design.numActiveMatPerRow << " " << design.numActiveMatPerColumn
+				<< " " << design.muxSenseAmp << " " << design.muxOutputLev1 << " " << design.muxOutputLev2
+				<< " " << design.numRowPerSet << " " << design.areaOptimizationLevel << " " << (int)design.memoryType
+				<< " " << saved.localWireType << " " << saved.localWireRepeaterType << " " << saved.isLocalWireLowSwing
+				<< " " << saved.globalWireType << " " << saved.globalWireRepeaterType << " " << saved.isGlobalWireLowSwing
+				<< " " << saved.tsvLocalWireType << " " << saved.tsvGlobalWireType;
+		WriteTSVState(file, saved.tsvState);
+	}
+	for (int i = 0; i < 12; i++)
+		file << " " << saved.limit[i];
+	file << endl;
+}
+
+static bool ReadResult(ifstream &file, const char *label, int idx, CheckpointResult &saved) {
+	string tag;
+	int savedIdx, memoryType;
+	file >> tag >> savedIdx >> saved.hasDesign;
+	if (tag != label || savedIdx != idx)
+		return false;
+	if (saved.hasDesign) {
+		DesignKey &design = saved.design;
+		file >> design.capacity >> design.blockSize >> design.associativity
+				>> design.numRowSubArray >> design.numColumnSubArray >> design.stackedDieCount
+				>> design.numActiveSubArrayPerRow >> design.numActiveSubArrayPerColumn
+				>> design.numRowMat >> design.numColumnMat
+				>> design.numActiveMatPerRow >> design.numActiveMatPerColumn
+				>> design.muxSenseAmp >> design.muxOutputLev1 >> design.muxOutputLev2
+				>> design.numRowPerSet >> design.areaOptimizationLevel >> memoryType
+				>> saved.localWireType >> saved.localWireRepeaterType >> saved.isLocalWireLowSwing
+				>> saved.globalWireType >> saved.globalWireRepeaterType >> saved.isGlobalWireLowSwing
+				>> saved.tsvLocalWireType >> saved.tsvGlobalWireType;
+		ReadTSVState(file, saved.tsvState);
+		design.memoryType = (MemoryType)memoryType;
+	}
+	for (int i = 0; i < 12; i++)
+		file >> saved.limit[i];
+	return !file.fail();
+}
+
+Checkpoint::Checkpoint() {
+	interval = 600;
+	lastSave = time(NULL);
+	resuming = false;
+
+	cellIdx = 0;
+	phase = tag_search;
+	position = 0;
+	numSolution = 0;
+	numDesigns = 0;
+	numPrunedDesigns = 0;
+	numDuplicateDesigns = 0;
+	tsvState = TSVState();
+	outputOffset = 0;
+	failures = 0;
+	totalSolutions = 0;
+}
+
+Checkpoint::~Checkpoint() {
+	// TODO Auto-generated destructor stub
+}
+
+bool Checkpoint::IsDue() {
+	return time(NULL) - lastSave >= interval;
+}
+
+void Checkpoint::Save() {
+	/* Write aside and rename, so a job killed mid-write still leaves the previous checkpoint */
+	string tempName = fileName + ".tmp";
+	ofstream file(tempName.c_str(), ofstream::out | ofstream::trunc);
+	if (!file.is_open()) {
+		cout << "[WARNING] Could not write checkpoint " << tempName << endl;
+		return;
+	}
+	file << setprecision(17) << scientific;
+	file << "Config: " << configFile << endl;
+	file << "InputHash: " << inputHash << endl;
+	file << "Cell: " << cellIdx << endl;
+	file << "Phase: " << (int)phase << endl;
+	file << "Position: " << position << endl;
+	file << "NumSolution: " << numSolution << endl;
+	file << "NumDesigns: " << numDesigns << endl;
+	file << "NumPrunedDesigns: " << numPrunedDesigns << endl;
+	file << "NumDuplicateDesigns: " << numDuplicateDesigns << endl;
+	file << "TSVState:";
+	WriteTSVState(file, tsvState);
+	file << endl;
+	file << "OutputOffset: " << outputOffset << endl;
+	file << "Failures: " << failures << endl;
+	file << "TotalSolutions: " << totalSolutions << endl;
+	file << "Results: " << dataResults.size() << endl;
+	for (int i = 0; i < (int)dataResults.size(); i++) {
+		WriteResult(file, "Data", i, dataResults[i]);
+		WriteResult(file, "Tag", i, tagResults[i]);
+	}
+	file.close();
+	if (file.fail() || rename(tempName.c_str(), fileName.c_str())) {
+		cout << "[WARNING] Could not write checkpoint " << fileName << endl;
+		return;
+	}
+	lastSave = time(NULL);
+}
+
+void Checkpoint::Load(const string &inputFile) {
+	ifstream file(inputFile.c_str());
+	if (!file.is_open()) {
+		cout << "[ERROR] Could not open checkpoint " << inputFile << endl;
+		exit(-1);
+	}
+	string label;
+	int savedPhase;
+	long long numResults;
+	file >> label;
+	getline(file, configFile);
+	configFile.erase(0, configFile.find_first_not_of(' '));
+	file >> label >> inputHash >> label >> cellIdx >> label >> savedPhase >> label >> position
+			>> label >> numSolution >> label >> numDesigns >> label >> numPrunedDesigns >> label >> numDuplicateDesigns
+			>> label;
+	ReadTSVState(file, tsvState);
+	file >> label >> outputOffset >> label >> failures >> label >> totalSolutions
+			>> label >> numResults;
+	phase = (SearchPhase)savedPhase;
+	bool valid = !file.fail() && label == "Results:" && !configFile.empty() && !inputHash.empty();
+	dataResults.resize(valid ? numResults : 0);
+	tagResults.resize(valid ? numResults : 0);
+	for (int i = 0; valid && i < (int)numResults; i++)
+		valid = ReadResult(file, "Data", i, dataResults[i]) && ReadResult(file, "Tag", i, tagResults[i]);
+	if (!valid) {
+		cout << "[ERROR] Checkpoint " << inputFile << " is corrupted" << endl;
+		exit(-1);
+	}
+	fileName = inputFile;
+	resuming = true;
+}
+
+void Checkpoint::StoreCell(int _cellIdx, Result *bestDataResults, Result *bestTagResults) {
+	if ((int)dataResults.size() < (_cellIdx + 1) * (int)full_exploration) {
+		dataResults.resize((_cellIdx + 1) * (int)full_exploration);
+		tagResults.resize((_cellIdx + 1) * (int)full_exploration);
+	}
+	for (int i = 0; i < (int)full_exploration; i++) {
+		StoreResult(bestDataResults[i], dataResults[_cellIdx * (int)full_exploration + i]);
+		StoreResult(bestTagResults[i], tagResults[_cellIdx * (int)full_exploration + i]);
+	}
+}
+
+/* Resuming after any of these files changed would mix results of two different explorations */
+string Checkpoint::HashInputs() {
+	unsigned long long hash = 14695981039346656037ULL;
+	hash = HashFile(configFile, hash);
+	for (int i = 0; i < (int)inputParameter->fileMemCell.size(); i++)
+		hash = HashFile(inputParameter->fileMemCell[i], hash);
+	if (!inputParameter->workloadStatsFile.empty())
+		hash = HashFile(inputParameter->workloadStatsFile, hash);
+	char text[17];
+	snprintf(text, sizeof(text), "%016llx", hash);
+	return text;
+}
+
+void Checkpoint::RestoreCell(int _cellIdx, Result *bestDataResults, Result *bestTagResults) {
+	if ((int)dataResults.size() < (_cellIdx + 1) * (int)full_exploration)
+		return;		/* Nothing recorded for this cell yet */
+	for (int i = 0; i < (int)full_exploration; i++) {
+		RestoreResult(dataResults[_cellIdx * (int)full_exploration + i], bestDataResults[i]);
+		RestoreResult(tagResults[_cellIdx * (int)full_exploration + i], bestTagResults[i]);
+	}
+}
@@ -0,0 +1,85 @@
+/*******************************************************************************
+* Copyright (c) 2025
+* Georgia Institute of Technology
+* 
+* This source code is part of NeuroSim (NS)-Cache - a framework developed for early
+* exploration of cache memories in advanced technology nodes (FinFET, nanosheet, CFET generations).
+* The tool extends previously developed Destiny, NVSim, and Cacti3dd. (Copyright Information Below)
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License (see LICENSE)
+*******************************************************************************/
+
+
+#ifndef CHECKPOINT_H_
+#define CHECKPOINT_H_
+
+#include <string>
+#include <vector>
+#include <time.h>
+
+#include "DesignKey.h"
+#include "Result.h"
+
+using namespace std;
+
+enum SearchPhase
+{
+	tag_search,			/* BIGFOR over the tag array */
+	data_search,		/* BIGFOR over the data array */
+	constrained_search	/* BIGFOR over the data array with the allowed limits applied */
+};
+
+/* One best-so-far record. The bank itself is not stored: evaluation is deterministic, so the */
+/* organization and wires are enough to rebuild it bit for bit. */
+struct CheckpointResult {
+	bool hasDesign;
+	DesignKey design;
+	int localWireType;			/* This one is actually WireType */
+	int localWireRepeaterType;	/* This one is actually WireRepeaterType */
+	int isLocalWireLowSwing;
+	int globalWireType;			/* This one is actually WireType */
+	int globalWireRepeaterType;	/* This one is actually WireRepeaterType */
+	int isGlobalWireLowSwing;
+	TSVState tsvState;			/* Of tech when it was evaluated */
+	int tsvLocalWireType;		/* The inputParameter->max*WireType it was evaluated under, they pick the TSV type */
+	int tsvGlobalWireType;
+	double limit[12];			/* Same order as the limit* fields in Result */
+};
+
+class Checkpoint {
+public:
+	Checkpoint();
+	virtual ~Checkpoint();
+
+	/* Functions */
+	bool IsDue();
+	void Save();
+	void Load(const string &inputFile);
+	void StoreCell(int _cellIdx, Result *bestDataResults, Result *bestTagResults);
+	void RestoreCell(int _cellIdx, Result *bestDataResults, Result *bestTagResults);
+	string HashInputs();
+
+	/* Properties */
+	string fileName;			/* Where the checkpoint is written */
+	string configFile;			/* The configuration file of the interrupted run */
+	string inputHash;			/* Of the configuration, cell, and workload files it was started with */
+	int interval;				/* Minimum time between two checkpoints, Unit: s */
+	time_t lastSave;
+	bool resuming;				/* Still catching up with the loaded checkpoint */
+
+	int cellIdx;				/* The memory cell being explored */
+	SearchPhase phase;
+	long long position;			/* BIGFOR iterations of this phase already done */
+	long long numSolution;
+	long long numDesigns;
+	long long numPrunedDesigns;
+	long long numDuplicateDesigns;
+	TSVState tsvState;			/* Of tech, later layer counts are only recomputed on a change */
+	long long outputOffset;		/* Bytes of the full exploration CSV written so far */
+	int failures;				/* Over the cells finished so far */
+	long long totalSolutions;	/* Over the cells finished so far */
+	vector<CheckpointResult> dataResults;	/* [cell * full_exploration + target] */
+	vector<CheckpointResult> tagResults;	/* [cell * full_exploration + target] */
+};
+
+#endif /* CHECKPOINT_H_ */
@@ -0,0 +1,428 @@
+/*******************************************************************************
+* Copyright (c) 2025
+* Georgia Institute of Technology
+*
+* This source code is part of NeuroSim (NS)-Cache - a framework developed for early
+* exploration of cache memories in advanced technology nodes (FinFET, nanosheet, CFET generations).
+* The tool extends previously developed Destiny, NVSim, and Cacti3dd. (Copyright Information Below)
+* Copyright of the model is maintained by the developers, and the model is distributed under
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License (see LICENSE)
+*******************************************************************************/
+
+
+#include "Cosim.h"
+#include "Workload.h"
+#include "global.h"
+#include "macros.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+Cosim::Cosim() {
+	inputFile = "";
+	configFile = "";
+	gem5Binary = "build/X86_MERSI_Three_Level/gem5.opt";
+	gem5Script = "configs/example/syscall_emulation.py";
+	gem5Options = "";
+	gem5Directory = ".";
+	runDirectory = "";
+	resultCacheFile = "";
+	controller = "l2_cntrl";
+	numJobs = 1;
+	candidatesPerRound = 4;
+	numRounds = 3;
+	bestCandidate = -1;
+	numRuns = 0;
+}
+
+Cosim::~Cosim() {
+	// TODO Auto-generated destructor stub
+}
+
+void Cosim::ReadFromFile(const string &_inputFile) {
+	inputFile = _inputFile;
+	FILE *fp = fopen(inputFile.c_str(), "r");
+	char line[5000];
+	char tmp[5000];
+
+	if (!fp) {
+		cout << inputFile << " cannot be found!\n";
+		exit(-1);
+	}
+
+	string stem = inputFile.substr(0, inputFile.find_last_of("."));
+	runDirectory = stem + "_runs";
+	resultCacheFile = stem + ".runs";
+
+	while (fscanf(fp, "%[^\n]\n", line) != EOF) {
+		if (!strncmp("-Config", line, strlen("-Config"))) {
+			sscanf(line, "-Config: %s", tmp);
+			configFile = (string)tmp;
+			continue;
+		}
+		if (!strncmp("-Gem5Binary", line, strlen("-Gem5Binary"))) {
+			sscanf(line, "-Gem5Binary: %s", tmp);
+			gem5Binary = (string)tmp;
+			continue;
+		}
+		if (!strncmp("-Gem5Script", line, strlen("-Gem5Script"))) {
+			sscanf(line, "-Gem5Script: %s", tmp);
+			gem5Script = (string)tmp;
+			continue;
+		}
+		if (!strncmp("-Gem5Options", line, strlen("-Gem5Options"))) {
+			/* The rest of the line, spaces included */
+			tmp[0] = '\0';
+			sscanf(line, "-Gem5Options: %[^\n]", tmp);
+			gem5Options = (string)tmp;
+			continue;
+		}
+		if (!strncmp("-Gem5Directory", line, strlen("-Gem5Directory"))) {
+			sscanf(line, "-Gem5Directory: %s", tmp);
+			gem5Directory = (string)tmp;
+			continue;
+		}
+		if (!strncmp("-RunDirectory", line, strlen("-RunDirectory"))) {
+			sscanf(line, "-RunDirectory: %s", tmp);
+			runDirectory = (string)tmp;
+			continue;
+		}
+		if (!strncmp("-ResultCache", line, strlen("-ResultCache"))) {
+			sscanf(line, "-ResultCache: %s", tmp);
+			resultCacheFile = (string)tmp;
+			continue;
+		}
+		if (!strncmp("-StatsController", line, strlen("-StatsController"))) {
+			sscanf(line, "-StatsController: %s", tmp);
+			controller = (string)tmp;
+			continue;
+		}
+		if (!strncmp("-Jobs", line, strlen("-Jobs"))) {
+			sscanf(line, "-Jobs: %d", &numJobs);
+			continue;
+		}
+		if (!strncmp("-CandidatesPerRound", line, strlen("-CandidatesPerRound"))) {
+			sscanf(line, "-CandidatesPerRound: %d", &candidatesPerRound);
+			continue;
+		}
+		if (!strncmp("-Rounds", line, strlen("-Rounds"))) {
+			sscanf(line, "-Rounds: %d", &numRounds);
+			continue;
+		}
+	}
+	fclose(fp);
+
+	if (configFile.empty()) {
+		cout << "[ERROR] " << inputFile << " does not specify the NS-Cache -Config of the L2" << endl;
+		exit(-1);
+	}
+	if (numJobs < 1 || candidatesPerRound < 1 || numRounds < 1) {
+		cout << "[ERROR] -Jobs, -CandidatesPerRound, and -Rounds have to be positive" << endl;
+		exit(-1);
+	}
+	/* gem5 runs from gem5Directory, so its --outdir has to be absolute */
+	if (runDirectory[0] != '/') {
+		char cwd[5000];
+		if (getcwd(cwd, sizeof(cwd)))
+			runDirectory = (string)cwd + "/" + runDirectory;
+	}
+}
+
+/* Designs with the same gem5 arguments only differ in power, one gem5 run serves all of them */
+void Cosim::BuildCandidates() {
+	map<string, int> byArguments;
+	for (int i = 0; i < (int)frontier.designs.size(); i++) {
+		const LevelDesign &design = frontier.designs[i];
+		if (design.gem5Arguments.empty())
+			continue;
+		if (byArguments.find(design.gem5Arguments) == byArguments.end()) {
+			CosimCandidate candidate;
+			candidate.gem5Arguments = design.gem5Arguments;
+			candidate.hitLatency = invalid_value;
+			candidate.evaluated = candidate.failed = false;
+			candidate.bestDesignIdx = -1;
+			candidate.llcPower = invalid_value;
+			candidate.perfPerWatt = 0;
+			byArguments[design.gem5Arguments] = candidates.size();
+			candidates.push_back(candidate);
+		}
+		CosimCandidate &candidate = candidates[byArguments[design.gem5Arguments]];
+		candidate.designIdx.push_back(i);
+		candidate.hitLatency = MIN(candidate.hitLatency, design.metric[hit_latency_metric]);
+	}
+	sort(candidates.begin(), candidates.end(),
+			[](const CosimCandidate &x, const CosimCandidate &y) { return x.hitLatency < y.hitLatency; });
+}
+
+/* One line per run: ipc, instructions, seconds, hits, misses, data writes, a tab, and the run key */
+void Cosim::LoadResultCache() {
+	ifstream file(resultCacheFile.c_str());
+	if (!file.is_open())
+		return;
+	string line;
+	while (getline(file, line)) {
+		size_t tab = line.find('\t');
+		if (tab == string::npos)
+			continue;
+		stringstream fields(line.substr(0, tab));
+		Gem5Run run;
+		if (fields >> run.ipc >> run.instructions >> run.simSeconds >> run.demandHits >> run.demandMisses >> run.dataArrayWrites)
+			resultCache[line.substr(tab + 1)] = run;
+	}
+	file.close();
+	cout << "[Info] " << resultCache.size() << " gem5 runs are cached in " << resultCacheFile << endl;
+}
+
+/* Everything the outcome of a gem5 run depends on, so another binary, script, or workload never */
+/* reuses the run of an earlier setup */
+string Cosim::RunKeyOf(const CosimCandidate &candidate) {
+	return "'" + gem5Directory + "' '" + gem5Binary + "' '" + gem5Script + "' " + gem5Options + " " + candidate.gem5Arguments;
+}
+
+string Cosim::RunDirectoryOf(const CosimCandidate &candidate) {
+	stringstream directory;
+	directory << runDirectory << "/run_" << hex << hash<string>()(RunKeyOf(candidate));
+	return directory.str();
+}
+
+/* IPC and instructions from stats.txt, the L2 traffic through Workload; false if the run left no statistics */
+bool Cosim::ReadRun(const string &outDirectory, Gem5Run &run) {
+	string statsFile = outDirectory + "/stats.txt";
+	ifstream file(statsFile.c_str());
+	if (!file.is_open())
+		return false;
+	double ipcSum = 0, instructions = 0;
+	int numCores = 0;
+	string line;
+	while (getline(file, line)) {
+		if (line.find("Begin Simulation Statistics") != string::npos) {
+			ipcSum = instructions = 0;
+			numCores = 0;
+			continue;
+		}
+		stringstream fields(line);
+		string name;
+		double value;
+		if (!(fields >> name >> value))
+			continue;
+		if (name == "simInsts" || name == "sim_insts")
+			instructions = value;
+		else if (name.find("cpu") != string::npos && name.size() > 4 && name.compare(name.size() - 4, 4, ".ipc") == 0) {
+			ipcSum += value;
+			numCores++;
+		}
+	}
+	file.close();
+	if (instructions <= 0)
+		return false;
+
+	Workload traffic;
+	traffic.ReadStatsFile(statsFile, controller);
+	run.ipc = numCores > 0 ? ipcSum / numCores : 0;
+	run.instructions = instructions;
+	run.simSeconds = traffic.simSeconds;
+	run.demandHits = traffic.demandHits;
+	run.demandMisses = traffic.demandMisses;
+	run.dataArrayWrites = traffic.dataArrayWrites;
+	return true;
+}
+
+/* LLC power is dynamic energy of the counted accesses over the run plus leakage and refresh, */
+/* the rest of the system is not modeled, so this ranks L2 designs, not whole systems */
+void Cosim::Evaluate(CosimCandidate &candidate) {
+	const Gem5Run &run = candidate.run;
+	candidate.evaluated = true;
+	candidate.perfPerWatt = 0;
+	if (run.simSeconds <= 0) {
+		/* A result cache line without simulated time has nothing to divide the energy by */
+		cout << "[WARNING] The gem5 run of " << candidate.gem5Arguments << " in " << resultCacheFile << " simulated no time" << endl;
+		candidate.failed = true;
+		return;
+	}
+	for (int i = 0; i < (int)candidate.designIdx.size(); i++) {
+		const double *metric = frontier.designs[candidate.designIdx[i]].metric;
+		double energy = run.demandHits * metric[hit_energy_metric] + run.demandMisses * metric[miss_energy_metric]
+				+ run.dataArrayWrites * metric[fill_energy_metric];
+		double power = energy / run.simSeconds + metric[leakage_metric] + metric[refresh_power_metric];
+		double perfPerWatt = run.instructions / run.simSeconds / power;
+		if (perfPerWatt > candidate.perfPerWatt) {
+			candidate.perfPerWatt = perfPerWatt;
+			candidate.llcPower = power;
+			candidate.bestDesignIdx = candidate.designIdx[i];
+		}
+	}
+}
+
+/* Cached candidates are evaluated right away, the rest run numJobs at a time */
+void Cosim::RunCandidates(const vector<int> &batch) {
+	vector<int> pending;
+	for (int i = 0; i < (int)batch.size(); i++) {
+		CosimCandidate &candidate = candidates[batch[i]];
+		map<string, Gem5Run>::iterator cached = resultCache.find(RunKeyOf(candidate));
+		if (cached != resultCache.end()) {
+			candidate.run = cached->second;
+			Evaluate(candidate);
+		} else {
+			pending.push_back(batch[i]);
+		}
+	}
+	if (pending.empty())
+		return;
+
+	mkdir(runDirectory.c_str(), 0755);
+	ofstream cacheFile(resultCacheFile.c_str(), ios::app);
+	cacheFile << scientific << setprecision(12);
+	map<pid_t, int> running;
+	int next = 0;
+	while (next < (int)pending.size() || !running.empty()) {
+		while (next < (int)pending.size() && (int)running.size() < numJobs) {
+			CosimCandidate &candidate = candidates[pending[next]];
+			string outDirectory = RunDirectoryOf(candidate);
+			mkdir(outDirectory.c_str(), 0755);
+			string command = "cd '" + gem5Directory + "' && '" + gem5Binary + "' --outdir='" + outDirectory + "' '" + gem5Script
+					+ "' " + gem5Options + " " + candidate.gem5Arguments + " > '" + outDirectory + "/gem5.log' 2>&1";
+			ofstream commandFile((outDirectory + "/command.sh").c_str());
+			commandFile << command << endl;
+			commandFile.close();
+
+			cout.flush();
+			pid_t pid = fork();
+			if (pid < 0) {
+				cout << "[ERROR] Cannot start gem5" << endl;
+				exit(-1);
+			}
+			if (pid == 0) {
+				execl("/bin/sh", "sh", "-c", command.c_str(), (char *)NULL);
+				_exit(-1);
+			}
+			cout << "[Info] gem5 run " << numRuns + 1 << " started in " << outDirectory << endl;
+			running[pid] = pending[next++];
+			numRuns++;
+		}
+
+		int status;
+		pid_t pid = wait(&status);
+		if (pid < 0)
+			break;
+		map<pid_t, int>::iterator done = running.find(pid);
+		if (done == running.end())
+			continue;
+		CosimCandidate &candidate = candidates[done->second];
+		running.erase(done);
+		string outDirectory = RunDirectoryOf(candidate);
+		if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || !ReadRun(outDirectory, candidate.run)) {
+			cout << "[WARNING] gem5 failed in " << outDirectory << ", see gem5.log there" << endl;
+			candidate.evaluated = candidate.failed = true;
+			continue;
+		}
+		const Gem5Run &run = candidate.run;
+		cacheFile << run.ipc << " " << run.instructions << " " << run.simSeconds << " " << run.demandHits << " "
+				<< run.demandMisses << " " << run.dataArrayWrites << "\t" << RunKeyOf(candidate) << endl;
+		resultCache[RunKeyOf(candidate)] = run;
+		Evaluate(candidate);
+	}
+	cacheFile.close();
+}
+
+int Cosim::Explore(const char *executable) {
+	string stem = inputFile.substr(0, inputFile.find_last_of("."));
+	string frontierFile = stem + ".pareto";
+	string logFile = stem + "_nsc.log";
+	cout << "[Info] Exploring " << configFile << " with NS-Cache" << endl;
+	pid_t pid = StartParetoRun(executable, frontierFile, configFile, logFile);
+	int status;
+	if (pid < 0 || waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		cout << "[ERROR] The exploration of " << configFile << " failed, see " << logFile << endl;
+		return 1;
+	}
+	frontier.ReadFromFile(frontierFile);
+	BuildCandidates();
+	if (candidates.empty()) {
+		cout << "[ERROR] " << configFile << " has no valid cache design to simulate" << endl;
+		return 1;
+	}
+	cout << "[Info] " << frontier.designs.size() << " designs on the Pareto frontier give " << candidates.size()
+			<< " distinct gem5 configurations" << endl;
+	LoadResultCache();
+
+	/* Sample the window evenly, then halve it around the best candidate so far */
+	int low = 0, high = candidates.size() - 1;
+	for (int round = 0; round < numRounds; round++) {
+		set<int> picked;
+		for (int i = 0; i < candidatesPerRound; i++) {
+			int idx = (candidatesPerRound == 1) ? (low + high) / 2
+					: low + (int)((double)i * (high - low) / (candidatesPerRound - 1) + 0.5);
+			if (!candidates[idx].evaluated)
+				picked.insert(idx);
+		}
+		vector<int> batch(picked.begin(), picked.end());
+		cout << "[Info] Round " << round + 1 << ": candidates " << low + 1 << " to " << high + 1 << ", "
+				<< batch.size() << " not evaluated yet" << endl;
+		RunCandidates(batch);
+
+		bestCandidate = -1;
+		for (int i = 0; i < (int)candidates.size(); i++)
+			if (candidates[i].evaluated && !candidates[i].failed
+					&& (bestCandidate < 0 || candidates[i].perfPerWatt > candidates[bestCandidate].perfPerWatt))
+				bestCandidate = i;
+		if (bestCandidate < 0 || low == high)
+			break;
+		int halfWidth = (high - low) / 4;
+		low = MAX(0, bestCandidate - halfWidth);
+		high = MIN((int)candidates.size() - 1, bestCandidate + halfWidth);
+	}
+	Print();
+	return bestCandidate < 0 ? 1 : 0;
+}
+
+void Cosim::Print() {
+	cout << endl << "=================================" << endl << "GEM5 CO-OPTIMIZATION -- SUMMARY" << endl << "=================================" << endl;
+	cout << "L2 Configuration: " << configFile << endl;
+	cout << "Objective: instructions per second per watt of L2 power" << endl;
+
+	vector<int> ranked;
+	for (int i = 0; i < (int)candidates.size(); i++)
+		if (candidates[i].evaluated && !candidates[i].failed)
+			ranked.push_back(i);
+	sort(ranked.begin(), ranked.end(),
+			[this](int x, int y) { return candidates[x].perfPerWatt > candidates[y].perfPerWatt; });
+	cout << "[Info] " << ranked.size() << " of " << candidates.size() << " candidates simulated, "
+			<< numRuns << " gem5 runs this time" << endl;
+	if (ranked.empty()) {
+		cout << "No candidate was simulated successfully." << endl;
+		return;
+	}
+
+	cout << "Rank  Hit Latency      IPC     MIPS    L2 Power     MIPS/W" << endl;
+	for (int i = 0; i < (int)ranked.size(); i++) {
+		const CosimCandidate &candidate = candidates[ranked[i]];
+		cout << setw(4) << i + 1 << "  " << setw(9) << candidate.hitLatency * 1e9 << "ns  " << setw(7) << candidate.run.ipc
+				<< "  " << setw(7) << candidate.run.instructions / candidate.run.simSeconds / 1e6 << "  " << setw(8)
+				<< candidate.llcPower * 1e3 << "mW  " << setw(9) << candidate.perfPerWatt / 1e6 << endl;
+	}
+
+	const CosimCandidate &best = candidates[ranked[0]];
+	const LevelDesign &design = frontier.designs[best.bestDesignIdx];
+	cout << "Best Design:" << endl;
+	cout << " - Organization = " << design.organization << endl;
+	cout << " - Hit Latency  = " << TO_SECOND(design.metric[hit_latency_metric]) << endl;
+	cout << " - Miss Latency = " << TO_SECOND(design.metric[miss_latency_metric]) << endl;
+	cout << " - IPC = " << best.run.ipc << endl;
+	cout << " - L2 Power = " << TO_WATT(best.llcPower) << endl;
+	cout << " - Performance per Watt = " << best.perfPerWatt / 1e6 << " MIPS/W" << endl;
+	cout << " - gem5 Output = " << RunDirectoryOf(best) << endl;
+	cout << "Usable GEM5 Command:" << endl;
+	cout << gem5Binary << " --outdir=<output_directory> " << gem5Script << " " << gem5Options << " " << best.gem5Arguments << endl;
+	cout << endl << "Finished!" << endl;
+}
@@ -0,0 +1,89 @@
+/*******************************************************************************
+* Copyright (c) 2025
+* Georgia Institute of Technology
+*
+* This source code is part of NeuroSim (NS)-Cache - a framework developed for early
+* exploration of cache memories in advanced technology nodes (FinFET, nanosheet, CFET generations).
+* The tool extends previously developed Destiny, NVSim, and Cacti3dd. (Copyright Information Below)
+* Copyright of the model is maintained by the developers, and the model is distributed under
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License (see LICENSE)
+*******************************************************************************/
+
+
+#ifndef COSIM_H_
+#define COSIM_H_
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "Hierarchy.h"
+
+using namespace std;
+
+/* What one gem5 run of a candidate reported */
+struct Gem5Run {
+	double ipc;					/* Averaged over the cores */
+	double instructions;		/* Committed by all the cores */
+	double simSeconds;			/* Unit: s */
+	double demandHits;			/* Summed over the L2 slices */
+	double demandMisses;
+	double dataArrayWrites;
+};
+
+/* The L2 designs that look identical to gem5, i.e. share their gem5 arguments */
+struct CosimCandidate {
+	string gem5Arguments;
+	vector<int> designIdx;		/* Into the frontier */
+	double hitLatency;			/* Fastest of designIdx, orders the candidates, Unit: s */
+	bool evaluated;
+	bool failed;
+	Gem5Run run;
+	int bestDesignIdx;			/* The design of designIdx with the best performance per watt */
+	double llcPower;			/* Of bestDesignIdx under run, Unit: W */
+	double perfPerWatt;			/* Instructions per second per watt of LLC power */
+};
+
+/* Closed loop between the NS-Cache exploration of an L2 and gem5 runs of its candidates */
+class Cosim {
+public:
+	Cosim();
+	virtual ~Cosim();
+
+	/* Functions */
+	void ReadFromFile(const string &inputFile);
+	int Explore(const char *executable);
+	void Print();
+
+	/* Properties */
+	string inputFile;
+	string configFile;			/* A regular NS-Cache configuration of the L2 cache */
+	string gem5Binary;			/* e.g. build/X86_MERSI_Three_Level/gem5.opt */
+	string gem5Script;			/* e.g. configs/example/syscall_emulation.py */
+	string gem5Options;			/* Workload, core, and L1 options, appended before the L2 arguments */
+	string gem5Directory;		/* gem5 runs from here */
+	string runDirectory;		/* Every run gets its --outdir under here */
+	string resultCacheFile;		/* Runs of earlier invocations, keyed by the whole gem5 command but its --outdir */
+	string controller;			/* The L2 controller in stats.txt */
+	int numJobs;				/* gem5 runs at a time */
+	int candidatesPerRound;
+	int numRounds;
+
+	ParetoFrontier frontier;
+	vector<CosimCandidate> candidates;	/* By hit latency */
+	int bestCandidate;
+	int numRuns;				/* gem5 runs this invocation, the rest came from the result cache */
+
+private:
+	void BuildCandidates();
+	void LoadResultCache();
+	void RunCandidates(const vector<int> &batch);
+	bool ReadRun(const string &outDirectory, Gem5Run &run);
+	void Evaluate(CosimCandidate &candidate);
+	string RunKeyOf(const CosimCandidate &candidate);
+	string RunDirectoryOf(const CosimCandidate &candidate);
+
+	map<string, Gem5Run> resultCache;
+};
+
+#endif /* COSIM_H_ */
@@ -0,0 +1,79 @@
+/*******************************************************************************
+* Copyright (c) 2025
+* Georgia Institute of Technology
+* 
+* This source code is part of NeuroSim (NS)-Cache - a framework developed for early
+* exploration of cache memories in advanced technology nodes (FinFET, nanosheet, CFET generations).
+* The tool extends previously developed Destiny, NVSim, and Cacti3dd. (Copyright Information Below)
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License (see LICENSE)
+*******************************************************************************/
+
+
+#include "DesignKey.h"
+#include "formula.h"
+
+DesignKey::DesignKey() {
+	capacity = 0;
+	blockSize = 0;
+	associativity = 0;
+	numRowSubArray = numColumnSubArray = stackedDieCount = 0;
+	numActiveSubArrayPerRow = numActiveSubArrayPerColumn = 0;
+	numRowMat = numColumnMat = numActiveMatPerRow = numActiveMatPerColumn = 0;
+	muxSenseAmp = muxOutputLev1 = muxOutputLev2 = numRowPerSet = 0;
+	areaOptimizationLevel = 0;
+	memoryType = MemoryType::data;
+}
+
+DesignKey::DesignKey(long long _capacity, long _blockSize, int _associativity, int _numRowSubArray, int _numColumnSubArray,
+		int _stackedDieCount, int _numActiveSubArrayPerRow, int _numActiveSubArrayPerColumn,
+		int _numRowMat, int _numColumnMat, int _numActiveMatPerRow, int _numActiveMatPerColumn,
+		int _muxSenseAmp, int _muxOutputLev1, int _muxOutputLev2, int _numRowPerSet,
+		int _areaOptimizationLevel, MemoryType _memoryType) {
+	capacity = _capacity;
+	blockSize = _blockSize;
+	associativity = _associativity;
+	numRowSubArray = _numRowSubArray;
+	numColumnSubArray = _numColumnSubArray;
+	stackedDieCount = _stackedDieCount;
+	/* Bank::Initialize and SubArray::Initialize clamp the active counts, so clamped tuples are the same design */
+	numActiveSubArrayPerRow = MIN(_numActiveSubArrayPerRow, numColumnSubArray);
+	numActiveSubArrayPerColumn = MIN(_numActiveSubArrayPerColumn, numRowSubArray);
+	numRowMat = _numRowMat;
+	numColumnMat = _numColumnMat;
+	numActiveMatPerRow = MIN(_numActiveMatPerRow, numColumnMat);
+	numActiveMatPerColumn = MIN(_numActiveMatPerColumn, numRowMat);
+	muxSenseAmp = _muxSenseAmp;
+	muxOutputLev1 = _muxOutputLev1;
+	muxOutputLev2 = _muxOutputLev2;
+	numRowPerSet = _numRowPerSet;
+	areaOptimizationLevel = _areaOptimizationLevel;
+	memoryType = _memoryType;
+}
+
+bool DesignKey::operator==(const DesignKey &rhs) const {
+	return capacity == rhs.capacity && blockSize == rhs.blockSize && associativity == rhs.associativity
+			&& numRowSubArray == rhs.numRowSubArray && numColumnSubArray == rhs.numColumnSubArray
+			&& stackedDieCount == rhs.stackedDieCount
+			&& numActiveSubArrayPerRow == rhs.numActiveSubArrayPerRow
+			&& numActiveSubArrayPerColumn == rhs.numActiveSubArrayPerColumn
+			&& numRowMat == rhs.numRowMat && numColumnMat == rhs.numColumnMat
+			&& numActiveMatPerRow == rhs.numActiveMatPerRow && numActiveMatPerColumn == rhs.numActiveMatPerColumn
+			&& muxSenseAmp == rhs.muxSenseAmp && muxOutputLev1 == rhs.muxOutputLev1 && muxOutputLev2 == rhs.muxOutputLev2
+			&& numRowPerSet == rhs.numRowPerSet && areaOptimizationLevel == rhs.areaOptimizationLevel
+			&& memoryType == rhs.memoryType;
+}
+
+size_t DesignKey::hash() const {
+	/* FNV-1a over the fields; every field is a small integer so this spreads well enough */
+	unsigned long long h = 14695981039346656037ULL;
+	long long fields[] = {capacity, blockSize, associativity, numRowSubArray, numColumnSubArray, stackedDieCount,
+			numActiveSubArrayPerRow, numActiveSubArrayPerColumn, numRowMat, numColumnMat, numActiveMatPerRow,
+			numActiveMatPerColumn, muxSenseAmp, muxOutputLev1, muxOutputLev2, numRowPerSet, areaOptimizationLevel,
+			(long long)memoryType};
+	for (unsigned i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+		h ^= (unsigned long long)fields[i];
+		h *= 1099511628211ULL;
+	}
+	return (size_t)h;
+}
@@ -0,0 +1,70 @@
+/*******************************************************************************
+* Copyright (c) 2025
+* Georgia Institute of Technology
+* 
+* This source code is part of NeuroSim (NS)-Cache - a framework developed for early
+* exploration of cache memories in advanced technology nodes (FinFET, nanosheet, CFET generations).
+* The tool extends previously developed Destiny, NVSim, and Cacti3dd. (Copyright Information Below)
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License (see LICENSE)
+*******************************************************************************/
+
+
+#ifndef DESIGNKEY_H_
+#define DESIGNKEY_H_
+
+#include <stddef.h>
+
+#include "typedef.h"
+
+/* Canonical identity of one array organization, with the same clamping Bank::Initialize applies */
+class DesignKey {
+public:
+	DesignKey();
+	DesignKey(long long _capacity, long _blockSize, int _associativity, int _numRowSubArray, int _numColumnSubArray,
+			int _stackedDieCount, int _numActiveSubArrayPerRow, int _numActiveSubArrayPerColumn,
+			int _numRowMat, int _numColumnMat, int _numActiveMatPerRow, int _numActiveMatPerColumn,
+			int _muxSenseAmp, int _muxOutputLev1, int _muxOutputLev2, int _numRowPerSet,
+			int _areaOptimizationLevel, MemoryType _memoryType);
+
+	bool operator==(const DesignKey &rhs) const;
+	size_t hash() const;
+
+	/* Properties */
+	long long capacity;
+	long blockSize;
+	int associativity;
+	int numRowSubArray;
+	int numColumnSubArray;
+	int stackedDieCount;
+	int numActiveSubArrayPerRow;
+	int numActiveSubArrayPerColumn;
+	int numRowMat;
+	int numColumnMat;
+	int numActiveMatPerRow;
+	int numActiveMatPerColumn;
+	int muxSenseAmp;
+	int muxOutputLev1;
+	int muxOutputLev2;
+	int numRowPerSet;
+	int areaOptimizationLevel;	/* This one is actually BufferDesignTarget */
+	MemoryType memoryType;
+};
+
+struct DesignKeyHash {
+	size_t operator()(const DesignKey &key) const { return key.hash(); }
+};
+
+/* The metrics the constraint filter looks at, kept so a seen design is not evaluated twice */
+struct DesignRecord {
+	double readLatency;
+	double writeLatency;
+	double readDynamicEnergy;
+	double writeDynamicEnergy;
+	double leakage;
+	double area;
+	double refreshLatency;
+	double refreshDynamicEnergy;
+};
+
+#endif /* DESIGNKEY_H_ */
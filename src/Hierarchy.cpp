@@ -0,0 +1,465 @@
+/*******************************************************************************
+* Copyright (c) 2025
+* Georgia Institute of Technology
+*
+* This source code is part of NeuroSim (NS)-Cache - a framework developed for early
+* exploration of cache memories in advanced technology nodes (FinFET, nanosheet, CFET generations).
+* The tool extends previously developed Destiny, NVSim, and Cacti3dd. (Copyright Information Below)
+* Copyright of the model is maintained by the developers, and the model is distributed under
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License (see LICENSE)
+*******************************************************************************/
+
+
+#include "Hierarchy.h"
+#include "Result.h"
+#include "global.h"
+#include "formula.h"
+#include "macros.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+/* a is no worse than b in any of the n metrics */
+static bool Covers(const double *a, const double *b, int n) {
+	for (int i = 0; i < n; i++)
+		if (a[i] > b[i])
+			return false;
+	return true;
+}
+
+ParetoFrontier::ParetoFrontier() {
+	cellFile = "";
+	numInserted = 0;
+	lastDominator = -1;
+}
+
+ParetoFrontier::~ParetoFrontier() {
+	// TODO Auto-generated destructor stub
+}
+
+/* Whether a design already kept is at least as good in every metric. Only the designs that hit no */
+/* slower can be, and the one that rejected the last design is tried first, since the designs of the */
+/* search come in neighbouring organizations that tend to fall to the same design. */
+bool ParetoFrontier::IsDominated(const double *metric) {
+	if (lastDominator >= 0 && lastDominator < (int)designs.size()
+			&& Covers(designs[lastDominator].metric, metric, num_level_metrics))
+		return true;
+	int end = upper_bound(designs.begin(), designs.end(), metric[hit_latency_metric],
+			[](double latency, const LevelDesign &kept) { return latency < kept.metric[hit_latency_metric]; }) - designs.begin();
+	for (int i = 0; i < end; i++)
+		if (Covers(designs[i].metric, metric, num_level_metrics)) {
+			lastDominator = i;
+			return true;
+		}
+	return false;
+}
+
+/* Drops the designs the new one dominates, which cannot hit faster than it, and keeps the order */
+void ParetoFrontier::Add(const LevelDesign &design) {
+	int begin = lower_bound(designs.begin(), designs.end(), design.metric[hit_latency_metric],
+			[](const LevelDesign &kept, double latency) { return kept.metric[hit_latency_metric] < latency; }) - designs.begin();
+	int kept = begin;
+	for (int i = begin; i < (int)designs.size(); i++)
+		if (!Covers(design.metric, designs[i].metric, num_level_metrics)) {
+			if (kept != i)
+				designs[kept] = move(designs[i]);
+			kept++;
+		}
+	designs.resize(kept);
+	designs.insert(designs.begin() + begin, design);
+	lastDominator = begin;
+}
+
+/* Same cache timing and energy model as Result::printAsCache, tagBank is NULL for a RAM. The report */
+/* strings are only built for the designs that make it onto the frontier. */
+void ParetoFrontier::Insert(const Bank *dataBank, const Bank *tagBank) {
+	LevelDesign design;
+	double *metric = design.metric;
+	if (tagBank == NULL) {
+		metric[hit_latency_metric] = metric[miss_latency_metric] = dataBank->readLatency;
+		metric[hit_energy_metric] = metric[miss_energy_metric] = dataBank->readDynamicEnergy;
+		metric[fill_energy_metric] = dataBank->writeDynamicEnergy;
+		metric[leakage_metric] = dataBank->leakage;
+		metric[area_metric] = dataBank->area;
+		metric[refresh_power_metric] = REFRESH_POWER(cell, dataBank);
+	} else {
+		metric[miss_latency_metric] = tagBank->readLatency;
+		metric[hit_energy_metric] = tagBank->readDynamicEnergy + dataBank->readDynamicEnergy;
+		if (inputParameter->cacheAccessMode == normal_access_mode) {
+			metric[hit_latency_metric] = MAX(tagBank->readLatency, dataBank->subarray.readLatency);
+			metric[hit_latency_metric] += dataBank->subarray.mat.columnDecoderLatency;
+			metric[hit_latency_metric] += dataBank->readLatency - dataBank->subarray.readLatency;
+			metric[miss_energy_metric] = tagBank->readDynamicEnergy + dataBank->readDynamicEnergy;
+		} else if (inputParameter->cacheAccessMode == fast_access_mode) {
+			metric[hit_latency_metric] = MAX(tagBank->readLatency, dataBank->readLatency);
+			metric[miss_energy_metric] = tagBank->readDynamicEnergy + dataBank->readDynamicEnergy;
+		} else {	/* sequential access */
+			metric[hit_latency_metric] = tagBank->readLatency + dataBank->readLatency;
+			metric[miss_energy_metric] = tagBank->readDynamicEnergy;
+		}
+		metric[fill_energy_metric] = tagBank->writeDynamicEnergy + dataBank->writeDynamicEnergy;
+		metric[leakage_metric] = tagBank->leakage + dataBank->leakage;
+		metric[area_metric] = tagBank->area + dataBank->area;
+		metric[refresh_power_metric] = REFRESH_POWER(cell, tagBank) + REFRESH_POWER(cell, dataBank);
+	}
+	numInserted++;
+	if (IsDominated(metric))
+		return;
+	if (tagBank != NULL)
+		design.gem5Arguments = Result::getGem5Arguments(dataBank, tagBank);
+
+	ostringstream organization;
+	organization << cellFile << ", Bank " << dataBank->numRowSubArray << "x" << dataBank->numColumnSubArray
+			<< " SubArrays (" << dataBank->numActiveSubArrayPerColumn << "x" << dataBank->numActiveSubArrayPerRow << " active), SubArray "
+			<< dataBank->numRowMat << "x" << dataBank->numColumnMat << " Mats (" << dataBank->numActiveMatPerColumn << "x"
+			<< dataBank->numActiveMatPerRow << " active), Mux " << dataBank->muxSenseAmp << "x" << dataBank->muxOutputLev1
+			<< "x" << dataBank->muxOutputLev2 << ", " << dataBank->stackedDieCount << " dies";
+	if (tagBank != NULL)
+		organization << ", Tag Bank " << tagBank->numRowSubArray << "x" << tagBank->numColumnSubArray << " SubArrays, Tag SubArray "
+				<< tagBank->numRowMat << "x" << tagBank->numColumnMat << " Mats, Tag Mux " << tagBank->muxSenseAmp << "x"
+				<< tagBank->muxOutputLev1 << "x" << tagBank->muxOutputLev2;
+	design.organization = organization.str();
+	Add(design);
+}
+
+void ParetoFrontier::WriteToFile(const string &fileName) {
+	ofstream file(fileName.c_str());
+	if (!file.is_open()) {
+		cout << "[ERROR] Cannot open the Pareto frontier file " << fileName << endl;
+		exit(-1);
+	}
+	file << numInserted << " " << designs.size() << endl << scientific << setprecision(12);
+	for (int i = 0; i < (int)designs.size(); i++) {
+		for (int j = 0; j < (int)num_level_metrics; j++)
+			file << designs[i].metric[j] << " ";
+		file << designs[i].organization << "\t" << designs[i].gem5Arguments << endl;
+	}
+	file.close();
+}
+
+void ParetoFrontier::ReadFromFile(const string &fileName) {
+	ifstream file(fileName.c_str());
+	if (!file.is_open()) {
+		cout << "[ERROR] Cannot open the Pareto frontier file " << fileName << endl;
+		exit(-1);
+	}
+	size_t numDesigns;
+	file >> numInserted >> numDesigns;
+	designs.resize(numDesigns);
+	for (size_t i = 0; i < numDesigns; i++) {
+		for (int j = 0; j < (int)num_level_metrics; j++)
+			file >> designs[i].metric[j];
+		file.get();	/* the separating space */
+		getline(file, designs[i].organization, '\t');
+		getline(file, designs[i].gem5Arguments);
+	}
+	if (file.fail()) {
+		cout << "[ERROR] " << fileName << " is not a valid Pareto frontier file" << endl;
+		exit(-1);
+	}
+	file.close();
+}
+
+Hierarchy::Hierarchy() {
+	inputFile = "";
+	objective = amat_objective;
+	areaBudget = invalid_value;
+	memoryLatency = 0;
+	memoryEnergy = 0;
+	accessInterval = 0;
+	bestObjective = bestAmat = bestEnergy = bestArea = bestLeakage = invalid_value;
+	numEvaluated = 0;
+}
+
+Hierarchy::~Hierarchy() {
+	// TODO Auto-generated destructor stub
+}
+
+void Hierarchy::ReadFromFile(const string &_inputFile) {
+	inputFile = _inputFile;
+	FILE *fp = fopen(inputFile.c_str(), "r");
+	char line[5000];
+	char tmp[5000];
+
+	if (!fp) {
+		cout << inputFile << " cannot be found!\n";
+		exit(-1);
+	}
+
+	while (fscanf(fp, "%[^\n]\n", line) != EOF) {
+		if (!strncmp("-Objective", line, strlen("-Objective"))) {
+			sscanf(line, "-Objective: %s", tmp);
+			if (!strcmp(tmp, "Energy"))
+				objective = energy_objective;
+			else
+				objective = amat_objective;
+			continue;
+		}
+		if (!strncmp("-AreaBudget", line, strlen("-AreaBudget"))) {
+			sscanf(line, "-AreaBudget (mm^2): %lf", &areaBudget);
+			areaBudget /= 1e6;
+			continue;
+		}
+		if (!strncmp("-MemoryLatency", line, strlen("-MemoryLatency"))) {
+			sscanf(line, "-MemoryLatency (ns): %lf", &memoryLatency);
+			memoryLatency /= 1e9;
+			continue;
+		}
+		if (!strncmp("-MemoryEnergy", line, strlen("-MemoryEnergy"))) {
+			sscanf(line, "-MemoryEnergy (nJ): %lf", &memoryEnergy);
+			memoryEnergy /= 1e9;
+			continue;
+		}
+		if (!strncmp("-AccessInterval", line, strlen("-AccessInterval"))) {
+			sscanf(line, "-AccessInterval (ns): %lf", &accessInterval);
+			accessInterval /= 1e9;
+			continue;
+		}
+		if (!strncmp("-Level", line, strlen("-Level"))) {
+			sscanf(line, "-Level: %s", tmp);
+			CacheLevel level;
+			level.configFile = (string)tmp;
+			level.hitRate = 0;
+			stringstream frontierFile;
+			frontierFile << inputFile.substr(0, inputFile.find_last_of(".")) << "_L" << levels.size() + 1 << ".pareto";
+			level.frontierFile = frontierFile.str();
+			levels.push_back(level);
+			continue;
+		}
+		if (!strncmp("-HitRate", line, strlen("-HitRate"))) {
+			if (levels.empty()) {
+				cout << "[ERROR] -HitRate has to follow the -Level it belongs to" << endl;
+				exit(-1);
+			}
+			sscanf(line, "-HitRate: %lf", &levels.back().hitRate);
+			continue;
+		}
+	}
+	fclose(fp);
+
+	if (levels.empty()) {
+		cout << "[ERROR] " << inputFile << " does not specify any -Level" << endl;
+		exit(-1);
+	}
+	for (int i = 0; i < (int)levels.size(); i++) {
+		if (levels[i].hitRate < 0 || levels[i].hitRate > 1) {
+			cout << "[ERROR] The hit rate of level " << i + 1 << " has to be between 0 and 1" << endl;
+			exit(-1);
+		}
+	}
+}
+
+pid_t StartParetoRun(const char *executable, const string &frontierFile, const string &configFile, const string &logFile) {
+	cout.flush();
+	pid_t pid = fork();
+	if (pid == 0) {
+		if (!freopen(logFile.c_str(), "w", stdout))
+			_exit(-1);
+		execl("/proc/self/exe", executable, "--pareto", frontierFile.c_str(), configFile.c_str(), (char *)NULL);
+		execlp(executable, executable, "--pareto", frontierFile.c_str(), configFile.c_str(), (char *)NULL);
+		_exit(-1);
+	}
+	return pid;
+}
+
+/* Every level is an independent exploration, so each one runs as its own nsc process */
+void Hierarchy::RunLevels(const char *executable) {
+	vector<pid_t> children;
+	string stem = inputFile.substr(0, inputFile.find_last_of("."));
+	cout << "[Info] Exploring " << levels.size() << " cache levels in parallel" << endl;
+	for (int i = 0; i < (int)levels.size(); i++) {
+		stringstream logFile;
+		logFile << stem << "_L" << i + 1 << ".log";
+		pid_t pid = StartParetoRun(executable, levels[i].frontierFile, levels[i].configFile, logFile.str());
+		if (pid < 0) {
+			cout << "[ERROR] Cannot start the exploration of level " << i + 1 << endl;
+			exit(-1);
+		}
+		children.push_back(pid);
+	}
+
+	bool failed = false;
+	for (int i = 0; i < (int)children.size(); i++) {
+		int status;
+		waitpid(children[i], &status, 0);
+		if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+			cout << "[ERROR] The exploration of level " << i + 1 << " (" << levels[i].configFile << ") failed, see "
+					<< stem << "_L" << i + 1 << ".log" << endl;
+			failed = true;
+		}
+	}
+	if (failed)
+		exit(-1);
+}
+
+/* Fold the hit rate in and drop the designs that cannot matter to the objective */
+void Hierarchy::PruneLevel(CacheLevel &level) {
+	double hitRate = level.hitRate, missRate = 1 - level.hitRate;
+	vector<LevelPoint> candidates;
+	for (int i = 0; i < (int)level.frontier.designs.size(); i++) {
+		const double *metric = level.frontier.designs[i].metric;
+		LevelPoint point;
+		point.latency = hitRate * metric[hit_latency_metric] + missRate * metric[miss_latency_metric];
+		point.energy = hitRate * metric[hit_energy_metric] + missRate * (metric[miss_energy_metric] + metric[fill_energy_metric]);
+		point.leakage = metric[leakage_metric] + metric[refresh_power_metric];
+		point.area = metric[area_metric];
+		point.designIdx = i;
+		if (point.area <= areaBudget)
+			candidates.push_back(point);
+	}
+
+	/* AMAT only sees latency; energy sees latency too unless the access interval is fixed */
+	level.points.clear();
+	for (int i = 0; i < (int)candidates.size(); i++) {
+		double a[4], b[4];
+		int n = 0;
+		bool dominated = false;
+		for (int j = 0; j < (int)candidates.size() && !dominated; j++) {
+			if (i == j)
+				continue;
+			n = 0;
+			if (objective == amat_objective || accessInterval == 0) {
+				a[n] = candidates[j].latency;
+				b[n++] = candidates[i].latency;
+			}
+			if (objective == energy_objective) {
+				a[n] = candidates[j].energy;
+				b[n++] = candidates[i].energy;
+				a[n] = candidates[j].leakage;
+				b[n++] = candidates[i].leakage;
+			}
+			a[n] = candidates[j].area;
+			b[n++] = candidates[i].area;
+			/* Of identical points keep the first one */
+			dominated = Covers(a, b, n) && (j < i || !Covers(b, a, n));
+		}
+		if (!dominated)
+			level.points.push_back(candidates[i]);
+	}
+
+	/* Visit promising designs first so the bound tightens early */
+	if (objective == amat_objective)
+		sort(level.points.begin(), level.points.end(),
+				[](const LevelPoint &x, const LevelPoint &y) { return x.latency < y.latency; });
+	else
+		sort(level.points.begin(), level.points.end(),
+				[](const LevelPoint &x, const LevelPoint &y) { return x.energy < y.energy; });
+}
+
+/* Branch and bound over the cross product, every level only adds to latency, energy, leakage, and area */
+void Hierarchy::Search(int levelIdx, double reach, double latency, double energy, double leakage, double area, vector<int> &choice) {
+	if (area + minRemainingArea[levelIdx] > areaBudget)
+		return;
+
+	if (levelIdx == (int)levels.size()) {
+		numEvaluated++;
+		double amat = latency + reach * memoryLatency;
+		double totalEnergy = energy + reach * memoryEnergy + leakage * (accessInterval > 0 ? accessInterval : amat);
+		double value = (objective == amat_objective) ? amat : totalEnergy;
+		if (value < bestObjective) {
+			bestObjective = value;
+			bestAmat = amat;
+			bestEnergy = totalEnergy;
+			bestArea = area;
+			bestLeakage = leakage;
+			bestChoice = choice;
+		}
+		return;
+	}
+
+	double minAmat = latency + reach * minRemainingLatency[levelIdx];
+	double bound = (objective == amat_objective) ? minAmat
+			: energy + reach * minRemainingEnergy[levelIdx] + leakage * (accessInterval > 0 ? accessInterval : minAmat);
+	if (bound >= bestObjective)
+		return;
+
+	const CacheLevel &level = levels[levelIdx];
+	for (int i = 0; i < (int)level.points.size(); i++) {
+		const LevelPoint &point = level.points[i];
+		choice[levelIdx] = i;
+		Search(levelIdx + 1, reach * (1 - level.hitRate), latency + reach * point.latency, energy + reach * point.energy,
+				leakage + point.leakage, area + point.area, choice);
+	}
+}
+
+int Hierarchy::Explore(const char *executable) {
+	RunLevels(executable);
+
+	for (int i = 0; i < (int)levels.size(); i++) {
+		levels[i].frontier.ReadFromFile(levels[i].frontierFile);
+		if (levels[i].frontier.designs.empty()) {
+			cout << "[ERROR] Level " << i + 1 << " (" << levels[i].configFile << ") has no valid design" << endl;
+			return 1;
+		}
+		PruneLevel(levels[i]);
+	}
+	minRemainingLatency.assign(levels.size() + 1, memoryLatency);
+	minRemainingEnergy.assign(levels.size() + 1, memoryEnergy);
+	minRemainingArea.assign(levels.size() + 1, 0);
+	for (int i = (int)levels.size() - 1; i >= 0; i--) {
+		double minLatency = invalid_value, minEnergy = invalid_value, minArea = invalid_value;
+		for (int j = 0; j < (int)levels[i].points.size(); j++) {
+			minLatency = MIN(minLatency, levels[i].points[j].latency);
+			minEnergy = MIN(minEnergy, levels[i].points[j].energy);
+			minArea = MIN(minArea, levels[i].points[j].area);
+		}
+		double missRate = 1 - levels[i].hitRate;
+		minRemainingLatency[i] = minLatency + missRate * minRemainingLatency[i + 1];
+		minRemainingEnergy[i] = minEnergy + missRate * minRemainingEnergy[i + 1];
+		minRemainingArea[i] = minArea + minRemainingArea[i + 1];
+	}
+
+	vector<int> choice(levels.size(), 0);
+	Search(0, 1, 0, 0, 0, 0, choice);
+	Print();
+	return bestChoice.empty() ? 1 : 0;
+}
+
+void Hierarchy::Print() {
+	cout << endl << "===========================" << endl << "HIERARCHY DESIGN -- SUMMARY" << endl << "===========================" << endl;
+	cout << "Objective: " << (objective == amat_objective ? "AMAT" : "Energy per access") << endl;
+	if (areaBudget < invalid_value)
+		cout << "Area Budget: " << areaBudget * 1e6 << "mm^2" << endl;
+	double combinations = 1;
+	for (int i = 0; i < (int)levels.size(); i++) {
+		cout << "Level " << i + 1 << " (" << levels[i].configFile << "): hit rate " << levels[i].hitRate * 100 << "%, "
+				<< levels[i].frontier.numInserted << " valid designs, " << levels[i].frontier.designs.size() << " on the Pareto frontier, "
+				<< levels[i].points.size() << " kept for the objective" << endl;
+		combinations *= levels[i].points.size();
+	}
+	cout << "[Info] Evaluated " << numEvaluated << " of " << scientific << setprecision(3) << combinations << fixed << setprecision(3)
+			<< " combinations of the kept designs" << endl;
+
+	if (bestChoice.empty()) {
+		cout << "No valid hierarchy within the area budget." << endl;
+		return;
+	}
+	cout << "Hierarchy:" << endl;
+	cout << " - AMAT = " << TO_SECOND(bestAmat) << endl;
+	cout << " - Energy per Access = " << TO_JOULE(bestEnergy) << endl;
+	cout << " - Total Leakage and Refresh Power = " << TO_WATT(bestLeakage) << endl;
+	cout << " - Total Area = " << bestArea * 1e6 << "mm^2" << endl;
+	for (int i = 0; i < (int)levels.size(); i++) {
+		const LevelDesign &design = levels[i].frontier.designs[levels[i].points[bestChoice[i]].designIdx];
+		cout << "Level " << i + 1 << " (" << levels[i].configFile << "):" << endl;
+		cout << " - Organization = " << design.organization << endl;
+		cout << " - Hit Latency  = " << TO_SECOND(design.metric[hit_latency_metric]) << endl;
+		cout << " - Miss Latency = " << TO_SECOND(design.metric[miss_latency_metric]) << endl;
+		cout << " - Hit Dynamic Energy  = " << TO_JOULE(design.metric[hit_energy_metric]) << endl;
+		cout << " - Miss Dynamic Energy = " << TO_JOULE(design.metric[miss_energy_metric]) << endl;
+		cout << " - Fill Dynamic Energy = " << TO_JOULE(design.metric[fill_energy_metric]) << endl;
+		cout << " - Leakage Power = " << TO_WATT(design.metric[leakage_metric]) << endl;
+		if (design.metric[refresh_power_metric] > 0)
+			cout << " - Refresh Power = " << TO_WATT(design.metric[refresh_power_metric]) << endl;
+		cout << " - Area = " << design.metric[area_metric] * 1e6 << "mm^2" << endl;
+	}
+	cout << endl << "Finished!" << endl;
+}
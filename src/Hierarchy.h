@@ -0,0 +1,126 @@
+/*******************************************************************************
+* Copyright (c) 2025
+* Georgia Institute of Technology
+*
+* This source code is part of NeuroSim (NS)-Cache - a framework developed for early
+* exploration of cache memories in advanced technology nodes (FinFET, nanosheet, CFET generations).
+* The tool extends previously developed Destiny, NVSim, and Cacti3dd. (Copyright Information Below)
+* Copyright of the model is maintained by the developers, and the model is distributed under
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License (see LICENSE)
+*******************************************************************************/
+
+
+#ifndef HIERARCHY_H_
+#define HIERARCHY_H_
+
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+#include "Bank.h"
+#include "typedef.h"
+
+using namespace std;
+
+enum LevelMetric
+{
+	hit_latency_metric,			/* Unit: s */
+	miss_latency_metric,		/* Tag lookup of a miss, Unit: s */
+	hit_energy_metric,			/* Unit: J */
+	miss_energy_metric,			/* Unit: J */
+	fill_energy_metric,			/* Writing the line a miss brings in, Unit: J */
+	leakage_metric,				/* Unit: W */
+	area_metric,				/* Unit: m^2 */
+	refresh_power_metric,		/* Unit: W */
+	num_level_metrics
+};
+
+/* One cache design of a level, as the hierarchy sees it */
+struct LevelDesign {
+	double metric[num_level_metrics];	/* Indexed by LevelMetric, lower is better for all of them */
+	string organization;				/* Cell file and data array organization, for the report */
+	string gem5Arguments;				/* What Result::getGem5Arguments gives for a cache, empty for a RAM */
+};
+
+/* A level design folded with the level's hit rate into what it adds to one access of the hierarchy */
+struct LevelPoint {
+	double latency;				/* hit rate * hit latency + miss rate * miss latency, Unit: s */
+	double energy;				/* hit rate * hit energy + miss rate * (miss + fill energy), Unit: J */
+	double leakage;				/* Leakage and refresh, Unit: W */
+	double area;				/* Unit: m^2 */
+	int designIdx;				/* Into the level's frontier */
+};
+
+/* Non-dominated designs of one cache level */
+class ParetoFrontier {
+public:
+	ParetoFrontier();
+	virtual ~ParetoFrontier();
+
+	/* Functions */
+	void Insert(const Bank *dataBank, const Bank *tagBank);
+	void WriteToFile(const string &fileName);
+	void ReadFromFile(const string &fileName);
+
+	/* Properties */
+	string cellFile;			/* Cell file of the designs being inserted */
+	long long numInserted;		/* Valid designs offered, dominated or not */
+	vector<LevelDesign> designs;	/* By hit latency */
+
+private:
+	bool IsDominated(const double *metric);
+	void Add(const LevelDesign &design);
+
+	int lastDominator;			/* Into designs, the one that rejected the last dominated design, -1 if none */
+};
+
+struct CacheLevel {
+	string configFile;			/* A regular NS-Cache configuration for this level */
+	double hitRate;				/* Local hit rate, of the accesses that reach this level */
+	string frontierFile;		/* Where the child run of this level leaves its frontier */
+	ParetoFrontier frontier;
+	vector<LevelPoint> points;	/* The frontier re-pruned for the objective */
+};
+
+/* Starts "executable --pareto frontierFile configFile" with its output in logFile */
+pid_t StartParetoRun(const char *executable, const string &frontierFile, const string &configFile, const string &logFile);
+
+class Hierarchy {
+public:
+	Hierarchy();
+	virtual ~Hierarchy();
+
+	/* Functions */
+	void ReadFromFile(const string &inputFile);
+	int Explore(const char *executable);
+	void Print();
+
+	/* Properties */
+	string inputFile;
+	vector<CacheLevel> levels;	/* From the one closest to the core */
+	HierarchyObjective objective;
+	double areaBudget;			/* Total area of all the levels, Unit: m^2 */
+	double memoryLatency;		/* Latency of the memory behind the last level, Unit: s */
+	double memoryEnergy;		/* Energy of one memory access, Unit: J */
+	double accessInterval;		/* Time between two accesses for the leakage energy, Unit: s, 0 for back-to-back accesses */
+
+	vector<int> bestChoice;		/* Index into levels[i].points of the best combination */
+	double bestObjective;
+	double bestAmat;			/* Unit: s */
+	double bestEnergy;			/* Per access, Unit: J */
+	double bestArea;			/* Unit: m^2 */
+	double bestLeakage;			/* Unit: W */
+	long long numEvaluated;		/* Full combinations the bounds did not cut off */
+
+private:
+	void RunLevels(const char *executable);
+	void PruneLevel(CacheLevel &level);
+	void Search(int levelIdx, double reach, double latency, double energy, double leakage, double area, vector<int> &choice);
+
+	/* Lower bounds of what levels i and up (memory included) add, per access that reaches level i */
+	vector<double> minRemainingLatency;
+	vector<double> minRemainingEnergy;
+	vector<double> minRemainingArea;
+};
+
+#endif /* HIERARCHY_H_ */
@@ -20,6 +20,7 @@
 #include "InputParameter.h"
 #include "global.h"
 #include "constant.h"
+#include "formula.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -81,6 +82,18 @@ InputParameter::InputParameter() {
 	addRepeaters = false;
 	clockFreq = 3e9;
 	quantize = false;
+	quantizedOptimization = false;
+	cycleTieBreak = area_optimized;
+	refreshSchedulePolicy = simultaneous_refresh;	/* No schedule file by default */
+	refreshScheduleFile = "refresh_schedule.txt";
+	refreshScheduleBanks = 0;
+	refreshPowerBudget = 0;			/* Legacy column-by-column refresh */
+	nucaSlices = 0;					/* Uniform latency by default */
+	nucaLatencyFile = "nuca_latency.txt";
+	pipelineDepth = 0;				/* One access at a time */
+	pipelineLatches = false;
+	workloadStatsFile = "";
+	workloadController = "l2_cntrl";
 
 	associativity = 1;				/* Default value for non-cache design */
 	routingMode = h_tree;
@@ -99,6 +112,8 @@ InputParameter::InputParameter() {
 	areaConstraint = invalid_value;
 	readEdpConstraint = invalid_value;
 	writeEdpConstraint = invalid_value;
+	refreshBusyRatioConstraint = invalid_value;
+	refreshPowerConstraint = invalid_value;
 	isConstraintApplied = false;
 	isPruningEnabled = false;
 	viewMatStats = false;
@@ -108,6 +123,10 @@ InputParameter::InputParameter() {
 	flashBlockSize = 0;
 
 	outputFilePrefix = "output";	/* Default output file name */
+	checkpointFile = "";			/* No checkpointing by default */
+	checkpointInterval = 600;
+	progressInterval = 0;			/* No progress reports by default */
+	progressFile = "";
 
     partitionGranularity = 0; /* 0: Coarse-Grained Bank Level (Just distribute subarrays evenly), 1: Fine-Grained Bank-Level (use N+1 layers with N layers of subarrays and one shared logic layer) */
     localTsvProjection = 1; /* 0: ITRS aggressive, 1: Industrial conservative */
@@ -121,7 +140,9 @@ InputParameter::InputParameter() {
 
     doublePrune = false;  // TODO
     printAllOptimals = false;
+    partialEvaluation = false;
     allowDifferentTagTech = false;
+    cacheLevelOptimization = false;
 	validated = true;
 
     printLevel = 1;
@@ -183,6 +204,14 @@ void InputParameter::ReadInputParameterFromFile(const std::string & inputFile) {
 				optimizationTarget = leakage_optimized;
 			else if (!strcmp(tmp, "Area"))
 				optimizationTarget = area_optimized;
+			else if (!strcmp(tmp, "RefreshBusyRatio"))
+				optimizationTarget = refresh_busy_optimized;
+			else if (!strcmp(tmp, "RefreshPower"))
+				optimizationTarget = refresh_power_optimized;
+			else if (!strcmp(tmp, "WorkloadEDP"))
+				optimizationTarget = workload_edp_optimized;
+			else if (!strcmp(tmp, "SustainedBandwidth"))
+				optimizationTarget = sustained_bandwidth_optimized;
 			else
 				optimizationTarget = full_exploration;
 			continue;
@@ -194,6 +223,28 @@ void InputParameter::ReadInputParameterFromFile(const std::string & inputFile) {
 			continue;
 		}
 
+		if (!strncmp("-CheckpointFile", line, strlen("-CheckpointFile"))) {
+			sscanf(line, "-CheckpointFile: %s", tmp);
+			checkpointFile = (string)tmp;
+			continue;
+		}
+
+		if (!strncmp("-CheckpointInterval", line, strlen("-CheckpointInterval"))) {
+			sscanf(line, "-CheckpointInterval (s): %d", &checkpointInterval);
+			continue;
+		}
+
+		if (!strncmp("-ProgressInterval", line, strlen("-ProgressInterval"))) {
+			sscanf(line, "-ProgressInterval (s): %d", &progressInterval);
+			continue;
+		}
+
+		if (!strncmp("-ProgressFile", line, strlen("-ProgressFile"))) {
+			sscanf(line, "-ProgressFile: %s", tmp);
+			progressFile = (string)tmp;
+			continue;
+		}
+
 		if (!strncmp("-ProcessNode", line, strlen("-ProcessNode"))) {
 			sscanf(line, "-ProcessNode: %d", &processNode);
 			continue;
@@ -634,6 +685,18 @@ void InputParameter::ReadInputParameterFromFile(const std::string & inputFile) {
 			continue;
 		}
 
+		if (!strncmp("-ApplyRefreshBusyRatioConstraint", line, strlen("-ApplyRefreshBusyRatioConstraint"))) {
+			sscanf(line, "-ApplyRefreshBusyRatioConstraint: %lf", &refreshBusyRatioConstraint);
+			isConstraintApplied = true;
+			continue;
+		}
+
+		if (!strncmp("-ApplyRefreshPowerConstraint", line, strlen("-ApplyRefreshPowerConstraint"))) {
+			sscanf(line, "-ApplyRefreshPowerConstraint: %lf", &refreshPowerConstraint);
+			isConstraintApplied = true;
+			continue;
+		}
+
 		if (!strncmp("-ViewMatStatistics", line, strlen("-ViewMatStatistics"))) {
 			sscanf(line, "-ViewMatStatistics: %s", tmp);
 			viewMatStats = true;
@@ -646,6 +709,96 @@ void InputParameter::ReadInputParameterFromFile(const std::string & inputFile) {
 			continue;
 		}
 
+		if (!strncmp("-QuantizedOptimization", line, strlen("-QuantizedOptimization"))) {
+			sscanf(line, "-QuantizedOptimization: %s", tmp);
+			if (!strcmp(tmp, "ReadDynamicEnergy"))
+				cycleTieBreak = read_energy_optimized;
+			else if (!strcmp(tmp, "WriteDynamicEnergy"))
+				cycleTieBreak = write_energy_optimized;
+			else if (!strcmp(tmp, "LeakagePower"))
+				cycleTieBreak = leakage_optimized;
+			else if (!strcmp(tmp, "Area"))
+				cycleTieBreak = area_optimized;
+			else {
+				cout << "[ERROR] -QuantizedOptimization has to be ReadDynamicEnergy, WriteDynamicEnergy, LeakagePower, or Area" << endl;
+				exit(-1);
+			}
+			quantizedOptimization = true;
+			quantize = true;	/* report the cycles that were optimized */
+			continue;
+		}
+
+		if (!strncmp("-WorkloadStats", line, strlen("-WorkloadStats"))) {
+			sscanf(line, "-WorkloadStats: %s", tmp);
+			workloadStatsFile = (string)tmp;
+			continue;
+		}
+
+		if (!strncmp("-WorkloadController", line, strlen("-WorkloadController"))) {
+			sscanf(line, "-WorkloadController: %s", tmp);
+			workloadController = (string)tmp;
+			continue;
+		}
+
+		if (!strncmp("-RefreshPowerBudget", line, strlen("-RefreshPowerBudget"))) {
+			sscanf(line, "-RefreshPowerBudget (mW): %lf", &refreshPowerBudget);
+			refreshPowerBudget /= 1e3;	/* Convert to W */
+			continue;
+		}
+
+		if (!strncmp("-PipelineDepth", line, strlen("-PipelineDepth"))) {
+			sscanf(line, "-PipelineDepth: %d", &pipelineDepth);
+			continue;
+		}
+
+		if (!strncmp("-PipelineLatches", line, strlen("-PipelineLatches"))) {
+			sscanf(line, "-PipelineLatches: %s", tmp);
+			if (!strcmp(tmp, "true"))
+				pipelineLatches = true;
+			else
+				pipelineLatches = false;
+			continue;
+		}
+
+		if (!strncmp("-NucaSlices", line, strlen("-NucaSlices"))) {
+			sscanf(line, "-NucaSlices: %d", &nucaSlices);
+			if (nucaSlices < 0 || (nucaSlices > 0 && !isPow2(nucaSlices))) {
+				cout << "[ERROR] -NucaSlices has to be a power of 2" << endl;
+				exit(-1);
+			}
+			continue;
+		}
+
+		if (!strncmp("-NucaLatencyFile", line, strlen("-NucaLatencyFile"))) {
+			sscanf(line, "-NucaLatencyFile: %s", tmp);
+			nucaLatencyFile = (string)tmp;
+			continue;
+		}
+
+		if (!strncmp("-RefreshScheduleFile", line, strlen("-RefreshScheduleFile"))) {
+			sscanf(line, "-RefreshScheduleFile: %s", tmp);
+			refreshScheduleFile = (string)tmp;
+			continue;
+		}
+
+		if (!strncmp("-RefreshScheduleBanks", line, strlen("-RefreshScheduleBanks"))) {
+			sscanf(line, "-RefreshScheduleBanks: %d", &refreshScheduleBanks);
+			continue;
+		}
+
+		if (!strncmp("-RefreshSchedule", line, strlen("-RefreshSchedule"))) {
+			sscanf(line, "-RefreshSchedule: %s", tmp);
+			if (!strcmp(tmp, "TotalFill"))
+				refreshSchedulePolicy = total_fill_refresh;
+			else if (!strcmp(tmp, "BackToBack"))
+				refreshSchedulePolicy = back_to_back_refresh;
+			else if (!strcmp(tmp, "PartialOverlap"))
+				refreshSchedulePolicy = partial_overlap_refresh;
+			else
+				refreshSchedulePolicy = simultaneous_refresh;
+			continue;
+		}
+
 		if (!strncmp("-M3DMemory", line, strlen("-M3DMemory"))) {
 			sscanf(line, "-M3DMemory: %s", tmp);
 			monolithic3DMat = true;
@@ -696,6 +849,15 @@ void InputParameter::ReadInputParameterFromFile(const std::string & inputFile) {
             continue;
         }
 
+        if (!strncmp("-PartialEvaluation", line, strlen("-PartialEvaluation"))) {
+            sscanf(line, "-PartialEvaluation: %s", tmp);
+            if (!strcmp(tmp, "true"))
+                partialEvaluation = true;
+            else
+                partialEvaluation = false;
+            continue;
+        }
+
         if (!strncmp("-AllowDifferentTagTech", line, strlen("-AllowDifferentTagTech"))) {
             sscanf(line, "-AllowDifferentTagTech: %s", tmp);
             if (!strcmp(tmp, "true"))
@@ -705,6 +867,15 @@ void InputParameter::ReadInputParameterFromFile(const std::string & inputFile) {
             continue;
         }
 
+        if (!strncmp("-CacheLevelOptimization", line, strlen("-CacheLevelOptimization"))) {
+            sscanf(line, "-CacheLevelOptimization: %s", tmp);
+            if (!strcmp(tmp, "true"))
+                cacheLevelOptimization = true;
+            else
+                cacheLevelOptimization = false;
+            continue;
+        }
+
         if (!strncmp("-PrintLevel", line, strlen("-PrintLevel"))) {
             sscanf(line, "-PrintLevel: %d", &printLevel);
         }
@@ -784,8 +955,45 @@ void InputParameter::PrintInputParameter() {
 		case leakage_optimized:
 			cout << "leakage power ..." << endl;
 			break;
+		case refresh_busy_optimized:
+			cout << "refresh busy ratio ..." << endl;
+			break;
+		case refresh_power_optimized:
+			cout << "refresh power ..." << endl;
+			break;
+		case workload_edp_optimized:
+			cout << "the energy-delay-product of the workload in " << workloadStatsFile << " ..." << endl;
+			break;
+		case sustained_bandwidth_optimized:
+			cout << "sustained read bandwidth ..." << endl;
+			break;
 		default:	/* area */
 			cout << "area ..." << endl;
 		}
+		if (quantizedOptimization && (optimizationTarget == read_latency_optimized || optimizationTarget == write_latency_optimized)) {
+			cout << "Latencies are ranked in cycles at " << clockFreq / 1e6 << "MHz, ties are broken by ";
+			switch (cycleTieBreak) {
+			case read_energy_optimized:
+				cout << "read energy" << endl;
+				break;
+			case write_energy_optimized:
+				cout << "write energy" << endl;
+				break;
+			case leakage_optimized:
+				cout << "leakage power" << endl;
+				break;
+			default:	/* area */
+				cout << "area" << endl;
+			}
+		}
 	}
+	if (refreshPowerBudget > 0)
+		cout << "Refresh Power Budget: " << refreshPowerBudget * 1e3 << "mW per bank" << endl;
+	if (cacheLevelOptimization && designTarget == cache)
+		cout << "Tag and data arrays are also paired for the cache-level optima" << endl;
+	if (pipelineDepth > 0)
+		cout << "Pipelined Bank: " << pipelineDepth << " reads in flight, H-tree levels "
+				<< (pipelineLatches ? "latched" : "not latched") << endl;
+	if (nucaSlices > 0)
+		cout << "Non-Uniform Cache Slices: " << nucaSlices << " (latency table in " << nucaLatencyFile << ")" << endl;
 }
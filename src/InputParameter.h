@@ -57,6 +57,8 @@ public:
 	double areaConstraint;			/* The allowed variation to the best leakage energy */
 	double readEdpConstraint;		/* The allowed variation to the best read EDP */
 	double writeEdpConstraint;		/* The allowed variation to the best write EDP */
+	double refreshBusyRatioConstraint;	/* The allowed variation to the best refresh busy ratio */
+	double refreshPowerConstraint;	/* The allowed variation to the best refresh power */
 	bool isConstraintApplied;		/* If any design constraint is applied */
 	bool isPruningEnabled;			/* Whether to prune the results during the exploration */
 	bool useCactiAssumption;		/* Use the CACTI assumptions on the array organization */
@@ -65,6 +67,18 @@ public:
 	int maxMatLayers;				/* Place limitation on the maximum number of Mat Layers in M3D */
 	double clockFreq;				/* For Gem5 Translation, What is the Clock Frequency? Units: Hz */
 	bool quantize;					/* For Gem5 Translation, Does the User want Quantized Parameters? */
+	bool quantizedOptimization;		/* Rank latency targets by cycles at clockFreq instead of seconds */
+	OptimizationTarget cycleTieBreak;	/* Breaks ties between designs with the same cycle counts */
+	RefreshSchedulePolicy refreshSchedulePolicy;	/* How gem5 banks stagger their refresh windows */
+	string refreshScheduleFile;		/* Where the per-bank refresh schedule is written */
+	int refreshScheduleBanks;		/* gem5 banks to schedule, 0 to use the subarrays of the design */
+	string workloadStatsFile;		/* gem5 stats.txt whose cache traffic WorkloadEDP is ranked by */
+	string workloadController;		/* Controller of the cache being designed in that file, e.g. l2_cntrl */
+	double refreshPowerBudget;		/* Peak refresh power of a bank, Unit: W, 0 to refresh one subarray column at a time */
+	int nucaSlices;					/* Slices of a non-uniform cache whose latencies follow their distance, 0 for a uniform bank */
+	string nucaLatencyFile;			/* Where the per-slice latency table is written */
+	int pipelineDepth;				/* Reads in flight in a pipelined bank, 0 if the pipeline is not modeled */
+	bool pipelineLatches;			/* Latch every H-tree level instead of the whole tree being one stage */
 
 	int associativity;				/* Associativity, for cache design only */
 	CacheAccessMode cacheAccessMode;	/* Access mode (for cache only) : normal, sequential, fast */
@@ -80,6 +94,10 @@ public:
 	double bufferSizeRatio;
 
 	string outputFilePrefix;
+	string checkpointFile;			/* Periodically save the search state here, empty to disable */
+	int checkpointInterval;			/* Unit: s */
+	int progressInterval;			/* Unit: s, 0 to disable progress reports */
+	string progressFile;			/* JSON-lines progress reports go here, empty for stderr */
 
 	int numRepeaters;
 	int minNumRowSubArray;
@@ -137,7 +155,9 @@ public:
 
     bool doublePrune;
     bool printAllOptimals;
+    bool partialEvaluation;			/* Skip the RC, latency, and power stages of designs whose area already rules them out */
     bool allowDifferentTagTech;
+    bool cacheLevelOptimization;	/* Pair tag and data designs under the cache access model, see CacheJoin */
 	bool addRepeaters;
 	bool viewMatStats;
 	int optNumRepeaters[25];
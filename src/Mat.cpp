@@ -453,6 +453,12 @@ void Mat::Initialize(long long _numRow, long long _numColumn, bool _multipleRowP
 		// TO-DO
 	}
 
+	/* Only the gain cell has a separate read port, the others precharge and read the same bitline */
+	if (cell->memCellType != gcDRAM) {
+		capWordlineRead = capWordline;
+		capBitlineRead = capBitline;
+	}
+
 	/* Repeater Insertion Scheme */
 	double rowDecoderCap;
 	double muxDecoderCap;
@@ -0,0 +1,122 @@
+/*******************************************************************************
+* Copyright (c) 2025
+* Georgia Institute of Technology
+*
+* This source code is part of NeuroSim (NS)-Cache - a framework developed for early
+* exploration of cache memories in advanced technology nodes (FinFET, nanosheet, CFET generations).
+* The tool extends previously developed Destiny, NVSim, and Cacti3dd. (Copyright Information Below)
+* Copyright of the model is maintained by the developers, and the model is distributed under
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License (see LICENSE)
+*******************************************************************************/
+
+
+#include "Progress.h"
+#include "global.h"
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <stdlib.h>
+
+/* JSON keys of the optimization targets, indexed by OptimizationTarget */
+static const char *targetKeys[(int)full_exploration] = {
+	"read_latency", "write_latency", "read_energy", "write_energy", "read_edp",
+	"write_edp", "read_bandwidth", "write_bandwidth", "leakage", "area",
+	"refresh_busy_ratio", "refresh_power", "workload_edp", "sustained_bandwidth"
+};
+
+static const char *phaseNames[] = {"tag", "data", "constrained"};
+
+Progress::Progress() {
+	fileName = "";
+	interval = 10;
+	cellIdx = 0;
+	numCells = 1;
+	lastReport = startTime = phaseStartTime = time(NULL);
+	phase = tag_search;
+	phaseIdx = numPhases = 1;
+	phaseSize = phaseStartPosition = phaseStartDesigns = 0;
+}
+
+Progress::~Progress() {
+	if (file.is_open())
+		file.close();
+}
+
+void Progress::Open(const string &_fileName) {
+	fileName = _fileName;
+	if (fileName.empty())
+		return;
+	file.open(fileName.c_str(), ofstream::out | ofstream::app);
+	if (!file.is_open()) {
+		cout << "[ERROR] Cannot open the progress file " << fileName << endl;
+		exit(-1);
+	}
+}
+
+void Progress::BeginPhase(SearchPhase _phase, long long _phaseSize, long long startPosition, long long startDesigns) {
+	phase = _phase;
+	phaseSize = _phaseSize;
+	phaseStartPosition = startPosition;
+	phaseStartDesigns = startDesigns;
+	phaseStartTime = time(NULL);
+
+	bool hasTag = (inputParameter->designTarget == cache);
+	bool hasConstrained = (inputParameter->isConstraintApplied && inputParameter->optimizationTarget != full_exploration);
+	numPhases = 1 + hasTag + hasConstrained;
+	phaseIdx = (int)phase + hasTag;
+}
+
+bool Progress::IsDue() {
+	return time(NULL) - lastReport >= interval;
+}
+
+void Progress::Report(long long position, long long numDesigns, long long numSolution, Result *bestResults) {
+	time_t now = time(NULL);
+	lastReport = now;
+
+	/* Rates only count the work done since this phase (re)started */
+	double phaseElapsed = difftime(now, phaseStartTime);
+	double positionRate = 0, designRate = 0, remaining = -1;
+	if (phaseElapsed > 0) {
+		positionRate = (position - phaseStartPosition) / phaseElapsed;
+		designRate = (numDesigns - phaseStartDesigns) / phaseElapsed;
+	}
+	if (positionRate > 0)
+		remaining = (phaseSize - position) / positionRate;
+	double fraction = phaseSize > 0 ? (double)position / phaseSize : 0;
+	double validFraction = numDesigns > 0 ? (double)numSolution / numDesigns : 0;
+
+	ostringstream line;
+	line << setprecision(6);
+	if (file.is_open()) {
+		line << "{\"elapsed\": " << (long long)difftime(now, startTime)
+			<< ", \"cell\": " << cellIdx + 1 << ", \"cells\": " << numCells
+			<< ", \"phase\": \"" << phaseNames[phase] << "\", \"phase_index\": " << phaseIdx << ", \"phases\": " << numPhases
+			<< ", \"position\": " << position << ", \"space\": " << phaseSize
+			<< ", \"designs\": " << numDesigns << ", \"valid_fraction\": " << validFraction
+			<< ", \"designs_per_second\": " << designRate << ", \"phase_remaining\": " << (long long)remaining
+			<< ", \"best\": {";
+		bool first = true;
+		for (int i = 0; i < (int)full_exploration; i++) {
+			if (bestResults[i].bank->area >= invalid_value)
+				continue;
+			line << (first ? "" : ", ") << "\"" << targetKeys[i] << "\": " << scientific << bestResults[i].getMetric((OptimizationTarget)i);
+			first = false;
+		}
+		line << "}}";
+		file << line.str() << endl;
+	} else {
+		line << fixed << setprecision(1) << "[Progress] cell " << cellIdx + 1 << "/" << numCells
+			<< ", " << phaseNames[phase] << " search " << phaseIdx << "/" << numPhases
+			<< ": " << fraction * 100 << "% of " << phaseSize << ", " << numDesigns << " designs at "
+			<< setprecision(0) << designRate << "/s, " << setprecision(1) << validFraction * 100 << "% valid";
+		if (remaining >= 0)
+			line << ", phase ETA " << (long long)remaining << " s";
+		OptimizationTarget target = inputParameter->optimizationTarget;
+		if (target != full_exploration && bestResults[target].bank->area < invalid_value)
+			line << ", best " << bestResults[target].printOptimizationTarget() << " = "
+				<< scientific << setprecision(3) << bestResults[target].getMetric(target);
+		cerr << line.str() << endl;
+	}
+}
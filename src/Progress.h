@@ -0,0 +1,53 @@
+/*******************************************************************************
+* Copyright (c) 2025
+* Georgia Institute of Technology
+*
+* This source code is part of NeuroSim (NS)-Cache - a framework developed for early
+* exploration of cache memories in advanced technology nodes (FinFET, nanosheet, CFET generations).
+* The tool extends previously developed Destiny, NVSim, and Cacti3dd. (Copyright Information Below)
+* Copyright of the model is maintained by the developers, and the model is distributed under
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License (see LICENSE)
+*******************************************************************************/
+
+
+#ifndef PROGRESS_H_
+#define PROGRESS_H_
+
+#include <fstream>
+#include <string>
+#include <time.h>
+
+#include "Checkpoint.h"
+#include "Result.h"
+
+using namespace std;
+
+class Progress {
+public:
+	Progress();
+	virtual ~Progress();
+
+	/* Functions */
+	void Open(const string &_fileName);
+	void BeginPhase(SearchPhase _phase, long long _phaseSize, long long startPosition, long long startDesigns);
+	bool IsDue();
+	void Report(long long position, long long numDesigns, long long numSolution, Result *bestResults);
+
+	/* Properties */
+	string fileName;			/* JSON-lines output, empty for a plain text line on stderr */
+	int interval;				/* Minimum time between two reports, Unit: s */
+	int cellIdx;				/* The memory cell being explored */
+	int numCells;
+	ofstream file;
+	time_t lastReport;
+	time_t startTime;			/* Of the whole run */
+	time_t phaseStartTime;
+	SearchPhase phase;
+	int phaseIdx;				/* 1-based position of phase among numPhases */
+	int numPhases;				/* Search phases of this cell, the tag search included */
+	long long phaseSize;		/* BIGFOR iterations of this phase */
+	long long phaseStartPosition;	/* Non-zero when the phase was resumed from a checkpoint */
+	long long phaseStartDesigns;
+};
+
+#endif /* PROGRESS_H_ */
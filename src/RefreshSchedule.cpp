@@ -0,0 +1,74 @@
+/*******************************************************************************
+* Copyright (c) 2025
+* Georgia Institute of Technology
+* 
+* This source code is part of NeuroSim (NS)-Cache - a framework developed for early
+* exploration of cache memories in advanced technology nodes (FinFET, nanosheet, CFET generations).
+* The tool extends previously developed Destiny, NVSim, and Cacti3dd. (Copyright Information Below)
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License (see LICENSE)
+*******************************************************************************/
+
+
+
+#include "RefreshSchedule.h"
+
+RefreshSchedule::RefreshSchedule() {
+	policy = simultaneous_refresh;
+	numBank = 0;
+	period = duration = 0;
+	overlapped = false;
+}
+
+RefreshSchedule::~RefreshSchedule() {
+	// TODO Auto-generated destructor stub
+}
+
+void RefreshSchedule::Initialize(RefreshSchedulePolicy _policy, int _numBank, uint64_t _period, uint64_t _duration) {
+	policy = _policy;
+	numBank = _numBank;
+	period = _period;
+	duration = _duration;
+	offset.assign(numBank, 0);
+	overlapped = false;
+
+	uint64_t step = 0;
+	switch (policy) {
+	case total_fill_refresh:
+		/* Spread the starts evenly so the last window still ends within the first period */
+		for (int i = 0; i < numBank; i++)
+			offset[i] = (period > duration) ? (period - duration) * i / numBank : 0;
+		break;
+	case back_to_back_refresh:
+		step = duration;
+		break;
+	case partial_overlap_refresh:
+		step = (duration + 1) / 2;
+		break;
+	default:	/* simultaneous */
+		;
+	}
+	if (step > 0) {
+		for (int i = 0; i < numBank; i++)
+			offset[i] = (step * i) % period;
+		overlapped = (step * numBank > period);
+	}
+}
+
+void RefreshSchedule::PrintToFile(ofstream &outputFile, const string &arrayName) {
+	for (int i = 0; i < numBank; i++)
+		outputFile << arrayName << " " << i << " " << offset[i] << " " << duration << " " << period << endl;
+}
+
+string RefreshSchedule::printPolicy() {
+	switch (policy) {
+	case total_fill_refresh:
+		return "TotalFill";
+	case back_to_back_refresh:
+		return "BackToBack";
+	case partial_overlap_refresh:
+		return "PartialOverlap";
+	default:	/* simultaneous */
+		return "Simultaneous";
+	}
+}
@@ -0,0 +1,47 @@
+/*******************************************************************************
+* Copyright (c) 2025
+* Georgia Institute of Technology
+* 
+* This source code is part of NeuroSim (NS)-Cache - a framework developed for early
+* exploration of cache memories in advanced technology nodes (FinFET, nanosheet, CFET generations).
+* The tool extends previously developed Destiny, NVSim, and Cacti3dd. (Copyright Information Below)
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License (see LICENSE)
+*******************************************************************************/
+
+
+
+#ifndef REFRESHSCHEDULE_H_
+#define REFRESHSCHEDULE_H_
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "typedef.h"
+
+using namespace std;
+
+/* Staggered refresh windows of the banks gem5 models, in cycles at -ClockFrequency. Bank i */
+/* refreshes for duration cycles at the end of every period-long window starting at offset[i]. */
+class RefreshSchedule {
+public:
+	RefreshSchedule();
+	virtual ~RefreshSchedule();
+
+	/* Functions */
+	void Initialize(RefreshSchedulePolicy _policy, int _numBank, uint64_t _period, uint64_t _duration);
+	void PrintToFile(ofstream &outputFile, const string &arrayName);
+	string printPolicy();
+
+	/* Properties */
+	RefreshSchedulePolicy policy;
+	int numBank;
+	uint64_t period;			/* Unit: cycle */
+	uint64_t duration;			/* Unit: cycle */
+	vector<uint64_t> offset;	/* Unit: cycle, one per bank */
+	bool overlapped;			/* Wrapped around the period, so some windows still coincide */
+};
+
+#endif /* REFRESHSCHEDULE_H_ */
@@ -21,12 +21,19 @@
 #include "global.h"
 #include "formula.h"
 #include "macros.h"
+#include "RefreshSchedule.h"
+#include "Workload.h"
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
 
 using namespace std;
 
+static const char *stageName[num_pipeline_stages] = {"Predecode", "Decode", "Bitline", "Mux", "Compare", "Routing", "TSV"};
+
 Result::Result() {
 	// TODO Auto-generated constructor stub
 	if (inputParameter->routingMode == h_tree)
@@ -57,11 +64,14 @@ Result::Result() {
 	limitWriteBandwidth = invalid_value_min;
 	limitArea = invalid_value;
 	limitLeakage = invalid_value;
+	limitRefreshBusyRatio = invalid_value;
+	limitRefreshPower = invalid_value;
 
 	/* Default read latency optimization */
 	optimizationTarget = read_latency_optimized;
 
     cellTech = NULL;
+	quantizationTag = NULL;
 }
 
 Result::~Result() {
@@ -112,6 +122,58 @@ double Result::getWriteBandwidth() const {
 	return (double)bank->blockSize / writeCycleLatency / 8;
 }
 
+/* Shortest time between two reads the bank accepts with numAccess of them interleaved over its */
+/* independent subarray groups. The routing and TSV stages are shared by every read. */
+double Result::getIssueInterval(const Bank *design, int numAccess) {
+	if (design->readLatency >= invalid_value / 10)
+		return invalid_value;
+	int numInterleaved = MAX(MIN(numAccess, design->numIndependentGroup), 1);
+	double localInterval = 0, sharedInterval = 0;
+	for (int i = 0; i < (int)num_pipeline_stages; i++) {
+		if (i == routing_stage || i == tsv_stage)
+			sharedInterval = MAX(sharedInterval, design->readStageLatency[i]);
+		else
+			localInterval = MAX(localInterval, design->readStageLatency[i]);
+	}
+	return MAX(sharedInterval, localInterval / numInterleaved);
+}
+
+/* Read bandwidth with -PipelineDepth reads in flight, which cannot complete faster than one read */
+/* latency each nor start faster than the initiation interval */
+double Result::getSustainedBandwidth() const {
+	if (bank->readLatency >= invalid_value / 10 || bank->blockSize <= 0)
+		return 0;
+	int numAccess = MAX(inputParameter->pipelineDepth, 1);
+	double interval = MAX(getIssueInterval(bank, numAccess), bank->readLatency / numAccess);
+	if (interval <= 0)
+		return 0;
+	return (double)bank->blockSize / interval / 8;
+}
+
+/* The cell this result was built from, the one being swept until main records it */
+MemCell *Result::getCellTech() const {
+	return cellTech ? cellTech : cell;
+}
+
+/* Whether the inputs this result's target ranks by are given, so the target is worth searching and */
+/* reporting. The selected target is always searched. */
+bool Result::isConfigured() const {
+	if (optimizationTarget == inputParameter->optimizationTarget)
+		return true;
+	MemCell *memCell = getCellTech();
+	switch (optimizationTarget) {
+	case refresh_busy_optimized:
+	case refresh_power_optimized:
+		return memCell->memCellType == eDRAM || memCell->memCellType == gcDRAM;
+	case workload_edp_optimized:
+		return workload != NULL;
+	case sustained_bandwidth_optimized:
+		return inputParameter->pipelineDepth > 0;
+	default:
+		return true;
+	}
+}
+
 bool Result::compareAndUpdate(Result &newResult) {
     bool toUpdate = false;
 
@@ -121,14 +183,19 @@ bool Result::compareAndUpdate(Result &newResult) {
 			&& newResult.bank->writeLatency * newResult.bank->writeDynamicEnergy <= limitWriteEdp
 			&& newResult.getReadBandwidth() >= limitReadBandwidth
 			&& newResult.getWriteBandwidth() >= limitWriteBandwidth
-			&& newResult.bank->area <= limitArea && newResult.bank->leakage <= limitLeakage) {
+			&& newResult.bank->area <= limitArea && newResult.bank->leakage <= limitLeakage
+			&& newResult.getRefreshBusyRatio() <= limitRefreshBusyRatio && newResult.getRefreshPower() <= limitRefreshPower) {
 		switch (optimizationTarget) {
 		case read_latency_optimized:
-			if 	(newResult.bank->readLatency < bank->readLatency)
+			if (inputParameter->quantizedOptimization)
+				toUpdate = hasFewerCycles(newResult);
+			else if 	(newResult.bank->readLatency < bank->readLatency)
 				toUpdate = true;
 			break;
 		case write_latency_optimized:
-			if 	(newResult.bank->writeLatency < bank->writeLatency)
+			if (inputParameter->quantizedOptimization)
+				toUpdate = hasFewerCycles(newResult);
+			else if 	(newResult.bank->writeLatency < bank->writeLatency)
 				toUpdate = true;
 			break;
 		case read_energy_optimized:
@@ -163,6 +230,24 @@ bool Result::compareAndUpdate(Result &newResult) {
 			if 	(newResult.bank->leakage < bank->leakage)
 				toUpdate = true;
 			break;
+		case refresh_busy_optimized:
+			if 	(newResult.getRefreshBusyRatio() < getRefreshBusyRatio())
+				toUpdate = true;
+			break;
+		case refresh_power_optimized:
+			if 	(newResult.getRefreshPower() < getRefreshPower())
+				toUpdate = true;
+			break;
+		case sustained_bandwidth_optimized:
+			if 	(newResult.getSustainedBandwidth() > getSustainedBandwidth())
+				toUpdate = true;
+			break;
+		case workload_edp_optimized:
+			/* A search candidate shares this target's tag, a best result from another cell brings its own */
+			if 	(newResult.getWorkloadEdp(newResult.quantizationTag ? newResult.quantizationTag : quantizationTag)
+					< getWorkloadEdp(quantizationTag))
+				toUpdate = true;
+			break;
 		default:	/* Exploration */
 			/* should not happen */
 			;
@@ -177,6 +262,299 @@ bool Result::compareAndUpdate(Result &newResult) {
     return toUpdate;
 }
 
+/* Cycles between two refreshes of a gem5 bank at -ClockFrequency; never for cells that do not refresh */
+uint64_t Result::getRefreshPeriodCycles(const Bank *design) {
+	if (cell->memCellType != eDRAM && cell->memCellType != gcDRAM)
+		return std::numeric_limits<uint64_t>::max();	/* 1e20 would overflow uint64_t */
+	double period = cell->retentionTime / design->numRowMat;
+	if (inputParameter->monolithic3DMat)
+		period /= design->subarray.mat.stackedMemTiers;
+	return static_cast<uint64_t>(ceil(period * inputParameter->clockFreq));
+}
+
+/* Cycles a gem5 bank is busy for each refresh: a read for eDRAM, a read and write-back for gain cells */
+uint64_t Result::getRefreshLatencyCycles(const Bank *design) {
+	double latency = 0;
+	if (cell->memCellType == eDRAM)
+		latency = design->subarray.readLatency;
+	else if (cell->memCellType == gcDRAM)
+		latency = design->subarray.readLatency + design->subarray.writeLatency;
+	return static_cast<uint64_t>(ceil(latency * inputParameter->clockFreq));
+}
+
+/* Writes where each gem5 bank's refresh window starts, for CacheMemory to hand to the refresh controllers. */
+/* One line per bank: array, bank, offset, duration, and period, all in cycles. */
+void Result::printRefreshScheduleToFile(Result *tagResult, const string &FileName) {
+	if (cell->memCellType != eDRAM && cell->memCellType != gcDRAM) {
+		cout << "[WARNING] " << FileName << " is not written, the memory cell does not need refresh" << endl;
+		return;
+	}
+	ofstream outFile(FileName.c_str());
+	if (!outFile.is_open()) {
+		cout << "[ERROR] Cannot open the refresh schedule file " << FileName << endl;
+		return;
+	}
+
+	/* Without a bank count from gem5, every subarray is refreshed on its own */
+	RefreshSchedule dataSchedule;
+	dataSchedule.Initialize(inputParameter->refreshSchedulePolicy, inputParameter->refreshScheduleBanks > 0 ?
+			inputParameter->refreshScheduleBanks : bank->numRowSubArray * bank->numColumnSubArray,
+			getRefreshPeriodCycles(bank), getRefreshLatencyCycles(bank));
+	outFile << "# NS-Cache refresh schedule, policy " << dataSchedule.printPolicy() << ", "
+			<< inputParameter->clockFreq / 1e6 << "MHz" << endl;
+	outFile << "# array bank offset duration period" << endl;
+	dataSchedule.PrintToFile(outFile, "data");
+	bool overlapped = dataSchedule.overlapped;
+	if (tagResult) {
+		RefreshSchedule tagSchedule;
+		tagSchedule.Initialize(inputParameter->refreshSchedulePolicy, inputParameter->refreshScheduleBanks > 0 ?
+				inputParameter->refreshScheduleBanks : tagResult->bank->numRowSubArray * tagResult->bank->numColumnSubArray,
+				getRefreshPeriodCycles(tagResult->bank), getRefreshLatencyCycles(tagResult->bank));
+		tagSchedule.PrintToFile(outFile, "tag");
+		overlapped = overlapped || tagSchedule.overlapped;
+	}
+	outFile.close();
+
+	cout << "[Info] " << dataSchedule.printPolicy() << " refresh schedule written to " << FileName << endl;
+	if (overlapped)
+		cout << "[WARNING] The banks do not fit in one refresh period back to back, some refresh windows still coincide" << endl;
+}
+
+/* Per-slice cache latencies of a -NucaSlices design, one gem5 L2 slice per line. The tag array uses */
+/* its own slices when it is split the same way, otherwise its uniform latency. */
+void Result::printNucaLatencyToFile(Result *tagResult, const string &FileName) {
+	if (bank->sliceReadLatency.empty()) {
+		if (inputParameter->routingMode != h_tree)
+			cout << "[WARNING] " << FileName << " is not written, only H-tree banks are split into slices" << endl;
+		else
+			cout << "[WARNING] " << FileName << " is not written, the bank has fewer subarrays than slices" << endl;
+		return;
+	}
+	ofstream outFile(FileName.c_str());
+	if (!outFile.is_open()) {
+		cout << "[ERROR] Cannot open the NUCA latency file " << FileName << endl;
+		return;
+	}
+
+	const Bank *tagBank = tagResult ? tagResult->bank : NULL;
+	bool slicedTag = tagBank && tagBank->numRowSlice == bank->numRowSlice && tagBank->numColumnSlice == bank->numColumnSlice
+			&& !tagBank->sliceReadLatency.empty();
+	Bank *dataSlice = new BankWithHtree();
+	Bank *tagSlice = new BankWithHtree();
+	*dataSlice = *bank;
+	if (tagBank)
+		*tagSlice = *tagBank;
+
+	double uniform[3], cycles[3], latencies[3];	/* hit, miss, write */
+	getAccessCycles(bank, tagBank, uniform);
+	double minHit = invalid_value, maxHit = 0;
+	outFile << "# NS-Cache non-uniform cache latency, " << bank->numRowSlice << "x" << bank->numColumnSlice << " slices, "
+			<< inputParameter->clockFreq / 1e6 << "MHz" << endl;
+	outFile << "# uniform " << uniform[0] << " " << uniform[1] << " " << uniform[2] << endl;
+	outFile << "# slice row column hit_cycles miss_cycles write_cycles hit_ns miss_ns write_ns" << endl;
+	for (int i = 0; i < (int)bank->sliceReadLatency.size(); i++) {
+		dataSlice->readLatency = bank->sliceReadLatency[i];
+		dataSlice->writeLatency = bank->sliceWriteLatency[i];
+		if (slicedTag) {
+			tagSlice->readLatency = tagBank->sliceReadLatency[i];
+			tagSlice->writeLatency = tagBank->sliceWriteLatency[i];
+		}
+		getAccessLatencies(dataSlice, tagBank ? tagSlice : NULL, latencies);
+		getAccessCycles(dataSlice, tagBank ? tagSlice : NULL, cycles);
+		outFile << i << " " << i / bank->numColumnSlice << " " << i % bank->numColumnSlice << " "
+				<< cycles[0] << " " << cycles[1] << " " << cycles[2] << " "
+				<< latencies[0] * 1e9 << " " << latencies[1] * 1e9 << " " << latencies[2] * 1e9 << endl;
+		minHit = MIN(minHit, cycles[0]);
+		maxHit = MAX(maxHit, cycles[0]);
+	}
+	outFile.close();
+	delete dataSlice;
+	delete tagSlice;
+
+	cout << "[Info] " << bank->sliceReadLatency.size() << " slice latencies written to " << FileName << ": hit "
+			<< (uint64_t)minHit << "-" << (uint64_t)maxHit << " cycles, " << (uint64_t)uniform[0] << " cycles uniform" << endl;
+	if (tagBank && !slicedTag)
+		cout << "[WARNING] The tag array is not split like the data array, its uniform latency is used for every slice" << endl;
+	cout << "[Info] gem5: --num-l2caches " << bank->sliceReadLatency.size() << " --l2_size "
+			<< bank->capacity / 8 / 1024 / bank->sliceReadLatency.size() << "kB --l2_nuca_latency " << FileName << endl;
+}
+
+/* Fraction of every retention period the bank cannot serve accesses because it is refreshing */
+double Result::getRefreshBusyRatio() const {
+	if (bank->area >= invalid_value)
+		return invalid_value;
+	return REFRESH_BUSY_RATIO(getCellTech(), bank);
+}
+
+/* Refresh energy of the whole bank spent once per retention period, Unit: W */
+double Result::getRefreshPower() const {
+	if (bank->area >= invalid_value)
+		return invalid_value;
+	return REFRESH_POWER(getCellTech(), bank);
+}
+
+/* Energy times stall time of the -WorkloadStats traffic on this result, paired with tagResult if it is */
+/* a cache data array. Every design ties at 0 when no workload is given. */
+double Result::getWorkloadEdp(const Result *tagResult) const {
+	if (bank->area >= invalid_value)
+		return invalid_value;
+	if (!workload)
+		return 0;
+	return workload->getEdp(bank, getCellTech(), tagResult);
+}
+
+/* The value compareAndUpdate ranks a result by for target, in the unit of that metric */
+double Result::getMetric(OptimizationTarget target) const {
+	switch (target) {
+	case read_latency_optimized:
+		return bank->readLatency;
+	case write_latency_optimized:
+		return bank->writeLatency;
+	case read_energy_optimized:
+		return bank->readDynamicEnergy;
+	case write_energy_optimized:
+		return bank->writeDynamicEnergy;
+	case read_edp_optimized:
+		return bank->readLatency * bank->readDynamicEnergy;
+	case write_edp_optimized:
+		return bank->writeLatency * bank->writeDynamicEnergy;
+	case read_bandwidth_optimized:
+		return getReadBandwidth();
+	case write_bandwidth_optimized:
+		return getWriteBandwidth();
+	case area_optimized:
+		return bank->area;
+	case leakage_optimized:
+		return bank->leakage;
+	case refresh_busy_optimized:
+		return getRefreshBusyRatio();
+	case refresh_power_optimized:
+		return getRefreshPower();
+	case workload_edp_optimized:
+		return getWorkloadEdp(quantizationTag);
+	case sustained_bandwidth_optimized:
+		return getSustainedBandwidth();
+	default:	/* Exploration */
+		/* should not happen */
+		return invalid_value;
+	}
+}
+
+/* Hit, miss, and write latencies of candidate, as printAsCache reports them. Without a */
+/* tag (tag arrays and RAM) they are the bank's own read, read, and write latencies. */
+void Result::getAccessLatencies(const Bank *candidate, const Bank *tagBank, double latencies[3]) {
+	double hitLatency, missLatency, writeLatency;
+	if (tagBank == NULL) {
+		hitLatency = missLatency = candidate->readLatency;
+		writeLatency = candidate->writeLatency;
+	} else {
+		missLatency = tagBank->readLatency;
+		writeLatency = MAX(tagBank->writeLatency, candidate->writeLatency);
+		if (inputParameter->cacheAccessMode == normal_access_mode) {
+			hitLatency = MAX(tagBank->readLatency, candidate->subarray.readLatency);
+			hitLatency += candidate->subarray.mat.columnDecoderLatency;
+			hitLatency += candidate->readLatency - candidate->subarray.readLatency;
+		} else if (inputParameter->cacheAccessMode == fast_access_mode) {
+			hitLatency = MAX(tagBank->readLatency, candidate->readLatency);
+		} else {	/* sequential access */
+			hitLatency = tagBank->readLatency + candidate->readLatency;
+		}
+	}
+	latencies[0] = hitLatency;
+	latencies[1] = missLatency;
+	latencies[2] = writeLatency;
+}
+
+/* The same three latencies in cycles at -ClockFrequency */
+void Result::getAccessCycles(const Bank *candidate, const Bank *tagBank, double cycles[3]) {
+	getAccessLatencies(candidate, tagBank, cycles);
+	for (int i = 0; i < 3; i++)
+		cycles[i] = ceil(cycles[i] * inputParameter->clockFreq);
+}
+
+/* The NS-Cache derived part of the gem5 command line that the cache summary prints */
+string Result::getGem5Arguments(const Bank *dataBank, const Bank *tagBank) {
+	double latencies[3];	/* hit, miss, write */
+	getAccessLatencies(dataBank, tagBank, latencies);
+
+	// helper: convert (seconds * Hz) -> integer cycles
+	auto cycles = [&](double seconds) -> uint64_t {
+	    return static_cast<uint64_t>(std::ceil(seconds * inputParameter->clockFreq));
+	};
+
+	ostringstream arguments;
+	arguments << fixed << setprecision(3);
+
+	// NS-Cache Derived Parameteric Outputs
+	arguments << "--l2_assoc " << inputParameter->associativity << " ";
+	arguments << "--cacheline_size " << inputParameter->wordWidth << " ";
+	arguments << "--sys-clock " << (inputParameter->clockFreq / 1e9) << "GHz ";
+	arguments << "--l2_size " << (dataBank->capacity / 1024 / 1024 / 8) << "MB ";
+
+	arguments << "--l2_data_hit_latency "   << cycles(latencies[0]) << " ";
+	arguments << "--l2_data_miss_latency "  << cycles(latencies[1]) << " ";
+	arguments << "--l2_data_write_latency " << cycles(latencies[2]) << " ";
+
+	arguments << "--l2_refresh_period " << getRefreshPeriodCycles(dataBank) << " ";
+	arguments << "--l2_refresh_latency " << getRefreshLatencyCycles(dataBank) << " ";
+
+	arguments << "--l2_refresh_enabled " << (cell->memCellType == eDRAM || cell->memCellType == gcDRAM) << " ";
+	// Bounds the period of elastic refresh in gem5; one refresh covers a row of every mat, and the
+	// refresh energy of the bank is spent over all its rows once per retention time
+	if (cell->memCellType == eDRAM || cell->memCellType == gcDRAM) {
+	    int rows = dataBank->numRowMat * (inputParameter->monolithic3DMat ? dataBank->subarray.mat.stackedMemTiers : 1);
+	    arguments << "--l2_retention_cycles " << cycles(cell->retentionTime) << " ";
+	    arguments << "--l2_refresh_rows " << rows << " ";
+	    arguments << "--l2_refresh_energy " << scientific << dataBank->refreshDynamicEnergy / rows << fixed << " ";
+	}
+	if (inputParameter->refreshSchedulePolicy != simultaneous_refresh)
+	    arguments << "--l2_refresh_schedule " << inputParameter->refreshScheduleFile << " ";
+
+	arguments << "--data_read_latency "  << cycles(dataBank->subarray.readLatency) << " ";
+	arguments << "--data_write_latency " << cycles(dataBank->subarray.writeLatency) << " ";
+	arguments << "--tag_read_latency "   << cycles(tagBank->subarray.readLatency) << " ";
+	arguments << "--tag_write_latency "  << cycles(tagBank->subarray.writeLatency) << " ";
+
+	// A pipelined read holds its gem5 bank for one initiation interval, gem5 interleaves over its banks itself
+	if (inputParameter->pipelineDepth > 0) {
+	    arguments << "--l2_data_issue_latency " << cycles(getIssueInterval(dataBank, 1)) << " ";
+	    arguments << "--l2_tag_issue_latency "  << cycles(getIssueInterval(tagBank, 1)) << " ";
+	}
+
+	// Calculate the serialized latency depending on access mode
+	if (inputParameter->cacheAccessMode == normal_access_mode) {
+	    const uint64_t tagCyc  = cycles(tagBank->readLatency + (dataBank->readLatency/2 - dataBank->subarray.readLatency));
+	    const uint64_t dataCyc = cycles(dataBank->readLatency/2 + dataBank->subarray.readLatency);
+	    const uint64_t serial  = (tagCyc + 1 > dataCyc) ? (tagCyc + 1 - dataCyc) : 0;
+	    arguments << "--serial_latency " << serial;
+	} else if (inputParameter->cacheAccessMode == sequential_access_mode) {
+	    arguments << "--serial_latency " << (cycles(latencies[1]) + 1);
+	} else {
+	    arguments << "--serial_latency " << 0;
+	}
+	return arguments.str();
+}
+
+/* Quantized ranking of the latency targets: the cycles gem5 will see come first (hit, miss, then */
+/* write for read latency; write first for write latency), and equal cycle counts go to the design */
+/* that is cheaper in -QuantizedOptimization's metric. */
+bool Result::hasFewerCycles(Result &newResult) const {
+	if (bank->area >= invalid_value)	/* nothing found yet, its timing is not set */
+		return true;
+	/* A search candidate shares this target's tag, a best result from another cell brings its own */
+	double newCycles[3], oldCycles[3];
+	Result *newTag = newResult.quantizationTag ? newResult.quantizationTag : quantizationTag;
+	getAccessCycles(newResult.bank, newTag ? newTag->bank : NULL, newCycles);
+	getAccessCycles(bank, quantizationTag ? quantizationTag->bank : NULL, oldCycles);
+	static const int readOrder[3] = {0, 1, 2}, writeOrder[3] = {2, 0, 1};
+	const int *order = (optimizationTarget == write_latency_optimized) ? writeOrder : readOrder;
+	for (int i = 0; i < 3; i++) {
+		if (newCycles[order[i]] != oldCycles[order[i]])
+			return newCycles[order[i]] < oldCycles[order[i]];
+	}
+	return newResult.getMetric(inputParameter->cycleTieBreak) < getMetric(inputParameter->cycleTieBreak);
+}
+
 string Result::printOptimizationTarget() {
     string rv;
 
@@ -211,6 +589,18 @@ string Result::printOptimizationTarget() {
     case leakage_optimized:
         rv = "Leakage";
         break;
+    case refresh_busy_optimized:
+        rv = "Refresh Busy Ratio";
+        break;
+    case refresh_power_optimized:
+        rv = "Refresh Power";
+        break;
+    case workload_edp_optimized:
+        rv = "Workload Energy-Delay-Product";
+        break;
+    case sustained_bandwidth_optimized:
+        rv = "Sustained Read Bandwidth";
+        break;
     default:	/* Exploration */
         /* should not happen */
         ;
@@ -569,6 +959,14 @@ void Result::print(int indent) {
 	cout << string(indent, ' ') << " - Read Bandwidth  = " << TO_BPS(readBandwidth) << endl;
 	double writeBandwidth = getWriteBandwidth();
 	cout << string(indent, ' ') << " - Write Bandwidth = " << TO_BPS(writeBandwidth) << endl;
+	if (inputParameter->pipelineDepth > 0) {
+		int slowestStage = max_element(bank->readStageLatency, bank->readStageLatency + num_pipeline_stages) - bank->readStageLatency;
+		cout << string(indent, ' ') << " - Sustained Read Bandwidth = " << TO_BPS(getSustainedBandwidth()) << endl;
+		cout << string(indent, ' ') << " |--- Initiation Interval = " << TO_SECOND(getIssueInterval(bank, inputParameter->pipelineDepth))
+				<< " over " << bank->numIndependentGroup << " subarray groups" << endl;
+		cout << string(indent, ' ') << " |--- Slowest Stage       = " << stageName[slowestStage] << ", "
+				<< TO_SECOND(bank->readStageLatency[slowestStage]) << endl;
+	}
 
 	cout << string(indent, ' ') << "Power:" << endl;
 
@@ -767,6 +1165,11 @@ void Result::print(int indent) {
 	cout << string(indent, ' ') << " |--- SubArray Leakage Power        = " << TO_WATT(bank->subarray.leakage) << " per subarray" << endl;
     if (cell->memCellType == eDRAM || cell->memCellType == gcDRAM) {
         cout << string(indent, ' ') << " - Refresh Power = " << TO_WATT(bank->refreshDynamicEnergy / (cell->retentionTime)) << endl;
+        if (inputParameter->refreshPowerBudget > 0) {
+            cout << string(indent, ' ') << " - Concurrent Refresh = " << bank->numConcurrentRefreshSubArray << " subarrays in "
+                    << bank->numRefreshStep << " rounds" << endl;
+            cout << string(indent, ' ') << " - Peak Refresh Power = " << TO_WATT(bank->refreshPeakPower) << endl;
+        }
     }
 }
 
@@ -1105,6 +1508,11 @@ void Result::printToFile(int indent, const string &FileName) {
 		outFile << string(indent, ' ') << "       |--- Charge Latency      = " << TO_SECOND(bank->subarray.mat.chargeLatency) << endl;
 	}
     if (cell->memCellType == eDRAM || cell->memCellType == gcDRAM) {
+        if (inputParameter->refreshPowerBudget > 0) {
+            outFile << string(indent, ' ') << " - Concurrent Refresh = " << bank->numConcurrentRefreshSubArray << " subarrays in "
+                    << bank->numRefreshStep << " rounds" << endl;
+            outFile << string(indent, ' ') << " - Peak Refresh Power = " << TO_WATT(bank->refreshPeakPower) << endl;
+        }
         outFile << string(indent, ' ') << " - Refresh Latency = " << TO_SECOND(bank->refreshLatency) << endl;
         if ((bank->stackedDieCount > 1 && bank->partitionGranularity == 0)) {
             outFile << string(indent, ' ') << " |--- TSV Latency    = " << TO_SECOND(bank->tsvArray.writeLatency * (bank->stackedDieCount-1)) << endl;
@@ -1130,6 +1538,14 @@ void Result::printToFile(int indent, const string &FileName) {
 	outFile << string(indent, ' ') << " - Read Bandwidth  = " << TO_BPS(readBandwidth) << endl;
 	double writeBandwidth = getWriteBandwidth();
 	outFile << string(indent, ' ') << " - Write Bandwidth = " << TO_BPS(writeBandwidth) << endl;
+	if (inputParameter->pipelineDepth > 0) {
+		int slowestStage = max_element(bank->readStageLatency, bank->readStageLatency + num_pipeline_stages) - bank->readStageLatency;
+		outFile << string(indent, ' ') << " - Sustained Read Bandwidth = " << TO_BPS(getSustainedBandwidth()) << endl;
+		outFile << string(indent, ' ') << " |--- Initiation Interval = " << TO_SECOND(getIssueInterval(bank, inputParameter->pipelineDepth))
+				<< " over " << bank->numIndependentGroup << " subarray groups" << endl;
+		outFile << string(indent, ' ') << " |--- Slowest Stage       = " << stageName[slowestStage] << ", "
+				<< TO_SECOND(bank->readStageLatency[slowestStage]) << endl;
+	}
 
 	outFile << string(indent, ' ') << "Power:" << endl;
 
@@ -1388,62 +1804,7 @@ void Result::printAsCache(Result &tagResult, CacheAccessMode cacheAccessMode) {
 			cout << "Usable GEM5 Command: (<string> indicates user inputed parameter)" << endl;
 			cout << "./build/X86_MERSI_Three_Level/gem5.opt --outdir=<output_directory>  configs/example/syscall_emulation.py --cmd <executable_path> --options=<executable_cmd_line_options>--ruby -n <num_cores> --mem-size <DRAM_capacity>GB --mem-type <DRAM_type> --l0i_size <L1I_Capacity_Per_Core>kB --l0d_size <L1D_Capacity_Per_Core>kB --l0i_assoc <L1I_Associativity> --l0d_assoc <L1D_Associativity> --l1d_size <L2_Capacity_Per_Core>kB --l1d_assoc <L2_Associativity> --cpu-type <CPU Type> ";
 			
-			// helper: convert (seconds * Hz) -> integer cycles
-			auto cycles = [&](double seconds) -> uint64_t {
-			    return static_cast<uint64_t>(std::ceil(seconds * inputParameter->clockFreq));
-			};
-			
-			// NS-Cache Derived Parameteric Outputs
-			cout << "--l2_assoc " << inputParameter->associativity << " ";
-			cout << "--cacheline_size " << inputParameter->wordWidth << " ";
-			cout << "--sys-clock " << (inputParameter->clockFreq / 1e9) << "GHz ";
-			cout << "--l2_size " << (bank->capacity / 1024 / 1024 / 8) << "MB ";
-			
-			cout << "--l2_data_hit_latency "   << cycles(cacheHitLatency)   << " ";
-			cout << "--l2_data_miss_latency "  << cycles(cacheMissLatency)  << " ";
-			cout << "--l2_data_write_latency " << cycles(cacheWriteLatency) << " ";
-			
-			if (cell->memCellType == eDRAM || cell->memCellType == gcDRAM) {
-			    if (inputParameter->monolithic3DMat) {
-			        cout << "--l2_refresh_period "
-			             << cycles(cell->retentionTime / bank->numRowMat / bank->subarray.mat.stackedMemTiers)
-			             << " ";
-			    } else {
-			        cout << "--l2_refresh_period "
-			             << cycles(cell->retentionTime / bank->numRowMat)
-			             << " ";
-			    }
-			} else {
-			    // 1e20 will overflow uint64_t; use a clear integer sentinel instead
-			    cout << "--l2_refresh_period " << std::numeric_limits<uint64_t>::max() << " ";
-			}
-			
-			if (cell->memCellType == eDRAM) {
-			    cout << "--l2_refresh_latency " << cycles(bank->subarray.readLatency) << " ";
-			} else if (cell->memCellType == gcDRAM) {
-			    cout << "--l2_refresh_latency " << cycles(bank->subarray.readLatency + bank->subarray.writeLatency) << " ";
-			} else {
-			    cout << "--l2_refresh_latency " << 0 << " ";
-			}
-			
-			cout << "--l2_refresh_enabled " << (cell->memCellType == eDRAM || cell->memCellType == gcDRAM) << " ";
-			
-			cout << "--data_read_latency "  << cycles(bank->subarray.readLatency) << " ";
-			cout << "--data_write_latency " << cycles(bank->subarray.writeLatency) << " ";
-			cout << "--tag_read_latency "   << cycles(tagResult.bank->subarray.readLatency) << " ";
-			cout << "--tag_write_latency "  << cycles(tagResult.bank->subarray.writeLatency) << " ";
-			
-			// Calculate the serialized latency depending on access mode
-			if (cacheAccessMode == normal_access_mode) {
-			    const uint64_t tagCyc  = cycles(tagResult.bank->readLatency + (bank->readLatency/2 - bank->subarray.readLatency));
-			    const uint64_t dataCyc = cycles(bank->readLatency/2 + bank->subarray.readLatency);
-			    const uint64_t serial  = (tagCyc + 1 > dataCyc) ? (tagCyc + 1 - dataCyc) : 0;
-			    cout << "--serial_latency " << serial << " \n\n";
-			} else if (cacheAccessMode == sequential_access_mode) {
-			    cout << "--serial_latency " << (cycles(cacheMissLatency) + 1) << " \n\n";
-			} else {
-			    cout << "--serial_latency " << 0 << " \n\n";
-			}
+			cout << getGem5Arguments(bank, tagResult.bank) << " \n\n";
 
 
 			cout << "-------------------------------------------------\n" << endl;
@@ -1465,6 +1826,12 @@ void Result::printAsCache(Result &tagResult, CacheAccessMode cacheAccessMode) {
         if (cell->memCellType == eDRAM || cell->memCellType == gcDRAM) {
             cout << " - Cache Refresh Power = " << TO_WATT(bank->refreshDynamicEnergy / (cell->retentionTime)) << " per bank" << endl;
         }
+		if (workload) {
+			cout << "Workload:" << endl;
+			cout << " - Cache Energy     = " << TO_JOULE(workload->getEnergy(bank, getCellTech(), &tagResult)) << endl;
+			cout << " - Cache Stall Time = " << TO_SECOND(workload->getStallTime(bank, &tagResult)) << endl;
+			cout << " - Cache Energy-Delay-Product = " << scientific << workload->getEdp(bank, getCellTech(), &tagResult) << fixed << "J-s" << endl;
+		}
         if (inputParameter->printLevel > 0) {
             cout << endl << "CACHE DATA ARRAY DETAILS";
             print(4);
@@ -38,9 +38,25 @@ public:
     bool nearReference(double reference, double measured);
 	void printToCsvFile(ofstream &outputFile);
 	void printAsCacheToCsvFile(Result &tagBank, CacheAccessMode cacheAccessMode, ofstream &outputFile);
+	void printRefreshScheduleToFile(Result *tagResult, const string &FileName);
+	void printNucaLatencyToFile(Result *tagResult, const string &FileName);
 	bool compareAndUpdate(Result &newResult);
+	bool isConfigured() const;
+	MemCell *getCellTech() const;
 	double getReadBandwidth() const;
 	double getWriteBandwidth() const;
+	static double getIssueInterval(const Bank *design, int numAccess);
+	double getSustainedBandwidth() const;
+	double getRefreshBusyRatio() const;
+	double getRefreshPower() const;
+	double getWorkloadEdp(const Result *tagResult) const;
+	static uint64_t getRefreshPeriodCycles(const Bank *design);
+	static uint64_t getRefreshLatencyCycles(const Bank *design);
+	double getMetric(OptimizationTarget target) const;
+	static void getAccessLatencies(const Bank *candidate, const Bank *tagBank, double latencies[3]);
+	static void getAccessCycles(const Bank *candidate, const Bank *tagBank, double cycles[3]);
+	static string getGem5Arguments(const Bank *dataBank, const Bank *tagBank);
+	bool hasFewerCycles(Result &newResult) const;
     string printOptimizationTarget();
 
 	OptimizationTarget optimizationTarget;	/* Exploration should not be assigned here */
@@ -59,7 +75,10 @@ public:
 	double limitWriteBandwidth;			/* The minimum allowable write bandwidth, Unit: B/s */
 	double limitArea;					/* The maximum allowable area, Unit: m^2 */
 	double limitLeakage;				/* The maximum allowable leakage power, Unit: W */
+	double limitRefreshBusyRatio;		/* The maximum allowable fraction of the retention time spent refreshing */
+	double limitRefreshPower;			/* The maximum allowable average refresh power, Unit: W */
     MemCell *cellTech;
+	Result *quantizationTag;			/* The tag result a data result is paired with when ranking by cycles or workload, NULL if none */
 };
 
 #endif /* RESULT_H_ */
@@ -2757,3 +2757,25 @@ void Technology::SetLayerCount(InputParameter *inputParameter, int layers)
 
     layerCount = layers;
 }
+
+TSVState Technology::GetTSVState() const
+{
+    TSVState state;
+    state.layerCount = layerCount;
+    for (int i = 0; i < NUM_TSV_TYPES; i++) {
+        state.capTSV[i] = capTSV[i];
+        state.resTSV[i] = resTSV[i];
+        state.areaTSV[i] = areaTSV[i];
+    }
+    return state;
+}
+
+void Technology::SetTSVState(const TSVState &state)
+{
+    layerCount = state.layerCount;
+    for (int i = 0; i < NUM_TSV_TYPES; i++) {
+        capTSV[i] = state.capTSV[i];
+        resTSV[i] = state.resTSV[i];
+        areaTSV[i] = state.areaTSV[i];
+    }
+}
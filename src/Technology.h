@@ -28,6 +28,14 @@
 
 using namespace std;
 
+/* The TSV parameters of a Technology, which depend on the layer count and wire types they were computed for */
+struct TSVState {
+	int layerCount;
+	double capTSV[NUM_TSV_TYPES];
+	double resTSV[NUM_TSV_TYPES];
+	double areaTSV[NUM_TSV_TYPES];
+};
+
 class Technology {
 public:
 	Technology();
@@ -97,6 +105,9 @@ public:
     double tsv_area(double tsv_pitch);
     TSV_type WireTypeToTSVType(int wiretype);
     void SetLayerCount(InputParameter *inputParameter, int layers); /* Recalculate TSV parameters based on layer count */
+    int GetLayerCount() const { return layerCount; }
+    TSVState GetTSVState() const;
+    void SetTSVState(const TSVState &state);	/* Put back TSV parameters saved by GetTSVState */
 
 private:
     // TSV parameters from CACTI3DD model
@@ -0,0 +1,163 @@
+/*******************************************************************************
+* Copyright (c) 2025
+* Georgia Institute of Technology
+*
+* This source code is part of NeuroSim (NS)-Cache - a framework developed for early
+* exploration of cache memories in advanced technology nodes (FinFET, nanosheet, CFET generations).
+* The tool extends previously developed Destiny, NVSim, and Cacti3dd. (Copyright Information Below)
+* Copyright of the model is maintained by the developers, and the model is distributed under
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License (see LICENSE)
+*******************************************************************************/
+
+
+#include "Workload.h"
+#include "global.h"
+#include "macros.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <set>
+#include <ctype.h>
+#include <stdlib.h>
+
+Workload::Workload() {
+	statsFile = "";
+	controller = "l2_cntrl";
+	numSlices = 0;
+	simSeconds = 0;
+	demandHits = demandMisses = 0;
+	tagArrayReads = tagArrayWrites = dataArrayReads = dataArrayWrites = 0;
+	tagArrayStalls = dataArrayStalls = 0;
+}
+
+Workload::~Workload() {
+	// TODO Auto-generated destructor stub
+}
+
+/* The path component naming one slice of controller, e.g. l2_cntrl3, or empty if there is none */
+static string SliceOf(const string &statName, const string &controller) {
+	stringstream path(statName);
+	string component;
+	while (getline(path, component, '.')) {
+		if (component.compare(0, controller.size(), controller) != 0)
+			continue;
+		size_t i = controller.size();
+		while (i < component.size() && isdigit(component[i]))
+			i++;
+		if (i == component.size())
+			return component;
+	}
+	return "";
+}
+
+void Workload::ReadStatsFile(const string &_statsFile, const string &_controller) {
+	statsFile = _statsFile;
+	controller = _controller;
+	ifstream file(statsFile.c_str());
+	if (!file.is_open()) {
+		cout << "[ERROR] Cannot open the gem5 statistics file " << statsFile << endl;
+		exit(-1);
+	}
+
+	set<string> slices;
+	string line;
+	while (getline(file, line)) {
+		if (line.find("Begin Simulation Statistics") != string::npos) {
+			/* A later dump replaces an earlier one */
+			simSeconds = 0;
+			demandHits = demandMisses = 0;
+			tagArrayReads = tagArrayWrites = dataArrayReads = dataArrayWrites = 0;
+			tagArrayStalls = dataArrayStalls = 0;
+			slices.clear();
+			continue;
+		}
+		stringstream fields(line);
+		string name;
+		double value;
+		if (!(fields >> name >> value))
+			continue;
+		if (name == "simSeconds" || name == "sim_seconds") {
+			simSeconds = value;
+			continue;
+		}
+		string slice = SliceOf(name, controller);
+		if (slice.empty())
+			continue;
+		string stat = name.substr(name.find_last_of(".") + 1);
+		double *counter = NULL;
+		if (stat == "m_demand_hits")
+			counter = &demandHits;
+		else if (stat == "m_demand_misses")
+			counter = &demandMisses;
+		else if (stat == "numTagArrayReads")
+			counter = &tagArrayReads;
+		else if (stat == "numTagArrayWrites")
+			counter = &tagArrayWrites;
+		else if (stat == "numDataArrayReads")
+			counter = &dataArrayReads;
+		else if (stat == "numDataArrayWrites")
+			counter = &dataArrayWrites;
+		else if (stat == "numTagArrayStalls")
+			counter = &tagArrayStalls;
+		else if (stat == "numDataArrayStalls")
+			counter = &dataArrayStalls;
+		if (counter) {
+			*counter += value;
+			slices.insert(slice);
+		}
+	}
+	file.close();
+	numSlices = slices.size();
+
+	if (numSlices == 0) {
+		cout << "[ERROR] " << statsFile << " has no cache statistics under " << controller << endl;
+		exit(-1);
+	}
+	if (simSeconds <= 0) {
+		cout << "[ERROR] " << statsFile << " does not report the simulated seconds" << endl;
+		exit(-1);
+	}
+}
+
+void Workload::PrintProperty() {
+	cout << "Workload: " << statsFile << " (" << numSlices << " " << controller << " slices, " << TO_SECOND(simSeconds) << " simulated)" << endl;
+	cout << " - Demand Hits / Misses     = " << (long long)demandHits << " / " << (long long)demandMisses << endl;
+	cout << " - Tag Array Reads / Writes  = " << (long long)tagArrayReads << " / " << (long long)tagArrayWrites << endl;
+	cout << " - Data Array Reads / Writes = " << (long long)dataArrayReads << " / " << (long long)dataArrayWrites << endl;
+	cout << " - Tag / Data Array Stalls   = " << (long long)tagArrayStalls << " / " << (long long)dataArrayStalls << endl;
+}
+
+/* Dynamic energy of the counted array accesses plus leakage and refresh over the run, Unit: J. */
+/* candidate is a data array paired with tagResult, a tag array on its own, or a RAM, built from memCell. */
+double Workload::getEnergy(const Bank *candidate, const MemCell *memCell, const Result *tagResult) const {
+	double energy = (candidate->leakage + REFRESH_POWER(memCell, candidate)) * simSeconds;
+	if (candidate->memoryType == MemoryType::tag)
+		return energy + tagArrayReads * candidate->readDynamicEnergy + tagArrayWrites * candidate->writeDynamicEnergy;
+
+	energy += dataArrayReads * candidate->readDynamicEnergy + dataArrayWrites * candidate->writeDynamicEnergy;
+	if (tagResult) {
+		const Bank *tagBank = tagResult->bank;
+		energy += (tagBank->leakage + REFRESH_POWER(tagResult->getCellTech(), tagBank)) * simSeconds;
+		energy += tagArrayReads * tagBank->readDynamicEnergy + tagArrayWrites * tagBank->writeDynamicEnergy;
+	}
+	return energy;
+}
+
+/* Time the controller spends on the counted accesses and array stalls, Unit: s */
+double Workload::getStallTime(const Bank *candidate, const Result *tagResult) const {
+	if (candidate->memoryType == MemoryType::tag)
+		return (demandHits + demandMisses + tagArrayStalls) * candidate->readLatency + tagArrayWrites * candidate->writeLatency;
+
+	if (tagResult == NULL)
+		return (dataArrayReads + dataArrayStalls) * candidate->readLatency + dataArrayWrites * candidate->writeLatency;
+
+	double latencies[3];	/* hit, miss, write */
+	Result::getAccessLatencies(candidate, tagResult->bank, latencies);
+	return demandHits * latencies[0] + demandMisses * latencies[1] + dataArrayWrites * latencies[2]
+			+ tagArrayStalls * tagResult->bank->readLatency + dataArrayStalls * candidate->readLatency;
+}
+
+double Workload::getEdp(const Bank *candidate, const MemCell *memCell, const Result *tagResult) const {
+	return getEnergy(candidate, memCell, tagResult) * getStallTime(candidate, tagResult);
+}
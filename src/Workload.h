@@ -0,0 +1,51 @@
+/*******************************************************************************
+* Copyright (c) 2025
+* Georgia Institute of Technology
+*
+* This source code is part of NeuroSim (NS)-Cache - a framework developed for early
+* exploration of cache memories in advanced technology nodes (FinFET, nanosheet, CFET generations).
+* The tool extends previously developed Destiny, NVSim, and Cacti3dd. (Copyright Information Below)
+* Copyright of the model is maintained by the developers, and the model is distributed under
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License (see LICENSE)
+*******************************************************************************/
+
+
+#ifndef WORKLOAD_H_
+#define WORKLOAD_H_
+
+#include <string>
+
+#include "Result.h"
+
+using namespace std;
+
+/* Traffic of one gem5 run at the cache controller being designed, summed over its slices. */
+/* The last statistics dump of stats.txt is used. */
+class Workload {
+public:
+	Workload();
+	virtual ~Workload();
+
+	/* Functions */
+	void ReadStatsFile(const string &_statsFile, const string &_controller);
+	void PrintProperty();
+	double getEnergy(const Bank *candidate, const MemCell *memCell, const Result *tagResult) const;
+	double getStallTime(const Bank *candidate, const Result *tagResult) const;
+	double getEdp(const Bank *candidate, const MemCell *memCell, const Result *tagResult) const;
+
+	/* Properties */
+	string statsFile;
+	string controller;			/* Stats under a path component starting with this, e.g. l2_cntrl */
+	int numSlices;				/* Controllers matched in the dump */
+	double simSeconds;			/* Unit: s */
+	double demandHits;
+	double demandMisses;
+	double tagArrayReads;
+	double tagArrayWrites;
+	double dataArrayReads;
+	double dataArrayWrites;
+	double tagArrayStalls;
+	double dataArrayStalls;
+};
+
+#endif /* WORKLOAD_H_ */
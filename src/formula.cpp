@@ -25,7 +25,7 @@ bool isPow2(int n) {
 	return !(n & (n - 1));
 }
 
-double CalculateGateCap(double width, Technology tech) {
+double CalculateGateCap(double width, const Technology &tech) {
 	    double widthEff = 0;
     if (tech.featureSize >= 22 * 1e-9) {
         widthEff = width;
@@ -41,19 +41,19 @@ double CalculateGateCap(double width, Technology tech) {
            + tech.phyGateLength * tech.capPolywire;
 }
 
-double CalculateFBRAMGateCap(double width, double thicknessFactor, Technology tech) {
+double CalculateFBRAMGateCap(double width, double thicknessFactor, const Technology &tech) {
 	return (tech.capIdealGate / thicknessFactor + tech.capOverlap + 3 * tech.capFringe) * width
 			+ tech.phyGateLength * tech.capPolywire;
 }
 
-double CalculateFBRAMDrainCap(double width, Technology tech) {
+double CalculateFBRAMDrainCap(double width, const Technology &tech) {
 	return (3 * tech.capSidewall + tech.capDrainToChannel) * width;
 }
 
 double CalculateGateArea(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double heightTransistorRegion, Technology tech,
+		double heightTransistorRegion, const Technology &tech,
 		double *height, double *width) {
 	 int speciallayout = 0;
 
@@ -420,7 +420,7 @@ double CalculateGateArea(
 void CalculateGateCapacitance(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double heightTransistorRegion, Technology tech,
+		double heightTransistorRegion, const Technology &tech,
 		double *capInput, double *capOutput) {
 
 	//cout << "in calculategatecapacitance" << endl;
@@ -1000,7 +1000,7 @@ void CalculateGateCapacitance(
 
 double CalculateDrainCap(
 		double width, int type,
-		double heightTransistorRegion, Technology tech) {
+		double heightTransistorRegion, const Technology &tech) {
 	double drainCap = 0;
 	if (type == NMOS)
 		CalculateGateCapacitance(INV, 1, width, 0, heightTransistorRegion, tech, NULL, &drainCap);
@@ -1012,14 +1012,14 @@ double CalculateDrainCap(
 double CalculateGateLeakage(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double temperature, Technology tech) {
+		double temperature, const Technology &tech) {
 	int tempIndex = (int)temperature - 300;
     if ((tempIndex > 100) || (tempIndex < 0)) {
         cout<<"Error: Temperature is out of range"<<endl;
         exit(-1);
     }
-    double *leakN = tech.currentOffNmos;
-    double *leakP = tech.currentOffPmos;
+    const double *leakN = tech.currentOffNmos;
+    const double *leakP = tech.currentOffPmos;
     double leakageN, leakageP;
 	
 	double widthNMOSEff, widthPMOSEff;
@@ -1066,7 +1066,7 @@ double CalculateGateLeakage(
     }
 }
 
-double CalculateOnResistance(double width, int type, double temperature, Technology tech) {
+double CalculateOnResistance(double width, int type, double temperature, const Technology &tech) {
 	double r;
     int tempIndex = (int)temperature - 300;
     if ((tempIndex > 100) || (tempIndex < 0)) {
@@ -1092,7 +1092,7 @@ double CalculateOnResistance(double width, int type, double temperature, Technol
     return r;
 }
 
-double CalculateOffResistance(double width, int type, double temperature, Technology tech) {
+double CalculateOffResistance(double width, int type, double temperature, const Technology &tech) {
 	double r;
     int tempIndex = (int)temperature - 300;
     if ((tempIndex > 100) || (tempIndex < 0)) {
@@ -1119,7 +1119,7 @@ double CalculateOffResistance(double width, int type, double temperature, Techno
 }
 
 
-double CalculateTransconductance(double width, int type, Technology tech) {
+double CalculateTransconductance(double width, int type, const Technology &tech) {
 	double gm;
 	double vsat;
 	double widthEff;
@@ -1180,7 +1180,7 @@ double CalculateWireCapacitance(
 
 // 1.4 update: add on resistance calculation without effective resistance multiplier 
 
-double CalculateOnResistance_normal(double width, int type, double temperature, Technology tech) {
+double CalculateOnResistance_normal(double width, int type, double temperature, const Technology &tech) {
     double r;
     int tempIndex = (int)temperature - 300;
     if ((tempIndex > 100) || (tempIndex < 0)) {
@@ -1206,7 +1206,7 @@ double CalculateOnResistance_normal(double width, int type, double temperature,
 
 double CalculateWireResistance_M0(
 		double resistivity, double wireWidth, double wireThickness,
-		double barrierThickness, double dishingThickness, double alphaScatter, bool neurosim_wiring, Technology tech) {
+		double barrierThickness, double dishingThickness, double alphaScatter, bool neurosim_wiring, const Technology &tech) {
 	if(!neurosim_wiring){
 		return(alphaScatter * resistivity / (wireThickness - barrierThickness - dishingThickness)
 			/ (wireWidth - 2 * barrierThickness));
@@ -1373,7 +1373,7 @@ double CalculateWireResistance_M0(
 
 double CalculateWireResistance_MX(
 		double resistivity, double wireWidth, double wireThickness,
-		double barrierThickness, double dishingThickness, double alphaScatter, bool neurosim_wiring, Technology tech) {
+		double barrierThickness, double dishingThickness, double alphaScatter, bool neurosim_wiring, const Technology &tech) {
 	if(!neurosim_wiring){
 		return(alphaScatter * resistivity / (wireThickness - barrierThickness - dishingThickness)
 			/ (wireWidth - 2 * barrierThickness));
@@ -1539,7 +1539,7 @@ double CalculateWireResistance_MX(
 }
 
 /* enlarge min size transister to max with same layout area */
-void EnlargeSize(double *widthNMOS, double *widthPMOS, double heightTransistorRegion, Technology tech) {	
+void EnlargeSize(double *widthNMOS, double *widthPMOS, double heightTransistorRegion, const Technology &tech) {	
     double	ratio = *widthPMOS / (*widthPMOS + *widthNMOS);
     double maxWidthPMOS, maxWidthNMOS;
     int maxNumPFin, maxNumNFin;	/* Max number of fins for the specified cell height */
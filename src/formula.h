@@ -29,65 +29,65 @@
 bool isPow2(int n);
 
 /* calculate the gate capacitance */
-double CalculateGateCap(double width, Technology tech);
+double CalculateGateCap(double width, const Technology &tech);
 
 double CalculateGateArea(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double heightTransistorRegion, Technology tech,
+		double heightTransistorRegion, const Technology &tech,
 		double *height, double *width);
 
 /* calculate the capacitance of a gate */
 void CalculateGateCapacitance(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double heightTransistorRegion, Technology tech,
+		double heightTransistorRegion, const Technology &tech,
 		double *capInput, double *capOutput);
 
 // GAA special layout 
 void CalculateGateCapacitance_GAA(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double heightTransistorRegion, Technology tech,
+		double heightTransistorRegion, const Technology &tech,
 		double *capInput, double *capOutput, double Gatefactor, double Ntuningfactor, double Ptuningfactor);
 
 double CalculateDrainCap(
 		double width, int type,
-		double heightTransistorRegion, Technology tech);
+		double heightTransistorRegion, const Technology &tech);
 
 /* calculate the capacitance of a FBRAM */
-double CalculateFBRAMGateCap(double width, double thicknessFactor, Technology tech);
+double CalculateFBRAMGateCap(double width, double thicknessFactor, const Technology &tech);
 
-double CalculateFBRAMDrainCap(double width, Technology tech);
+double CalculateFBRAMDrainCap(double width, const Technology &tech);
 
 double CalculateGateLeakage(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double temperature, Technology tech);
+		double temperature, const Technology &tech);
 
-double CalculateOnResistance(double width, int type, double temperature, Technology tech);
+double CalculateOnResistance(double width, int type, double temperature, const Technology &tech);
 
-double CalculateOffResistance(double width, int type, double temperature, Technology tech);
+double CalculateOffResistance(double width, int type, double temperature, const Technology &tech);
 
-double CalculateTransconductance(double width, int type, Technology tech);
+double CalculateTransconductance(double width, int type, const Technology &tech);
 
 double horowitz(double tr, double beta, double rampInput, double *rampOutput);
 
 double CalculateWireResistance_M0(
 		double resistivity, double wireWidth, double wireThickness,
-		double barrierThickness, double dishingThickness, double alphaScatter, bool neurosim_wiring, Technology tech);
+		double barrierThickness, double dishingThickness, double alphaScatter, bool neurosim_wiring, const Technology &tech);
 
 double CalculateWireResistance_MX(
 		double resistivity, double wireWidth, double wireThickness,
-		double barrierThickness, double dishingThickness, double alphaScatter, bool neurosim_wiring, Technology tech);
+		double barrierThickness, double dishingThickness, double alphaScatter, bool neurosim_wiring, const Technology &tech);
 
 double CalculateWireCapacitance(
 		double permittivity, double wireWidth, double wireThickness, double wireSpacing,
 		double ildThickness, double millarValue, double horizontalDielectric,
 		double verticalDielectic, double fringeCap, bool neurosim_wiring);
 
-double CalculateOnResistance_normal(double width, int type, double temperature, Technology tech);
+double CalculateOnResistance_normal(double width, int type, double temperature, const Technology &tech);
 
-void EnlargeSize(double *widthNMOS, double *widthPMOS, double heightTransistorRegion, Technology tech);
+void EnlargeSize(double *widthNMOS, double *widthPMOS, double heightTransistorRegion, const Technology &tech);
 
 #endif /* FORMULA_H_ */
@@ -13,6 +13,8 @@
 #include "MemCell.h"
 #include "Wire.h"
 
+class Workload;
+
 extern InputParameter *inputParameter;
 extern Technology *tech;
 extern Technology *devtech;
@@ -21,6 +23,7 @@ extern Technology *gtech;
 extern Wire *localWire;		/* The wire type of local interconnects (for example, wire in subarray) */
 extern Wire *globalWire;	/* The wire type of global interconnects (for example, the ones that connect subarrays) */
 extern MemCell **sweepCells;
+extern Workload *workload;	/* Traffic of -WorkloadStats, NULL if none */
 
 const double invalid_value = 1e41;
 const double invalid_value_min = 1e-41;
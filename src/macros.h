@@ -110,7 +110,56 @@
 
 
 
-#define CALCULATE(bank, memoryType) { \
+#define RESUME_SEARCH_PHASE(searchPhase) { \
+	searchPosition = 0; \
+	resumePosition = (resuming && resumePhase == (searchPhase)) ? checkpoint->position : 0; \
+}
+
+
+/* Must be the first statement of a BIGFOR body, so that positions count every enumerated tuple */
+#define CHECKPOINT_OR_SKIP(searchPhase) { \
+	if (searchPosition < resumePosition) { \
+		searchPosition++; \
+		continue; \
+	} \
+	if (checkpoint && (searchPosition & 0x3ff) == 0 && checkpoint->IsDue()) { \
+		checkpoint->phase = (searchPhase); \
+		checkpoint->position = searchPosition; \
+		checkpoint->numSolution = numSolution; \
+		checkpoint->numDesigns = numDesigns; \
+		checkpoint->numPrunedDesigns = numPrunedDesigns; \
+		checkpoint->numDuplicateDesigns = numDuplicateDesigns; \
+		checkpoint->tsvState = tech->GetTSVState(); \
+		if (outputFile.is_open()) { \
+			outputFile.flush(); \
+			checkpoint->outputOffset = (long long)outputFile.tellp(); \
+		} \
+		checkpoint->StoreCell(checkpoint->cellIdx, bestDataResults, bestTagResults); \
+		checkpoint->Save(); \
+	} \
+	searchPosition++; \
+}
+
+
+
+/* Sizes the phase by walking the bare loop nest, which is negligible next to evaluating it */
+#define BEGIN_PROGRESS_PHASE(searchPhase) { \
+	if (progress) { \
+		long long searchSpaceSize = 0; \
+		BIGFOR searchSpaceSize++; \
+		progress->BeginPhase((searchPhase), searchSpaceSize, resumePosition, numDesigns); \
+	} \
+}
+
+
+#define REPORT_PROGRESS(bestResults) { \
+	if (progress && (searchPosition & 0x3ff) == 0 && progress->IsDue()) \
+		progress->Report(searchPosition, numDesigns, numSolution, (bestResults)); \
+}
+
+
+
+#define CALCULATE_AREA(bank, memoryType) { \
 	if (inputParameter->routingMode == h_tree) \
 		(bank) = new BankWithHtree(); \
 	else \
@@ -121,17 +170,74 @@
 				numActiveMatPerRow, numActiveMatPerColumn, (BufferDesignTarget)areaOptimizationLevel, \
                 (memoryType), stackedDieCount, partitionGranularity, inputParameter->monolithicStackCount); \
 	(bank)->CalculateArea(); \
+}
+
+
+#define CALCULATE_LATENCY_AND_POWER(bank) { \
 	(bank)->CalculateRC(); \
 	(bank)->CalculateLatencyAndPower(); \
 }
 
 
+#define CALCULATE(bank, memoryType) { \
+	CALCULATE_AREA(bank, memoryType); \
+	CALCULATE_LATENCY_AND_POWER(bank); \
+}
+
+
+/* The geometry stage alone decides validity (except the DRAM retention check) and area, */
+/* so a design that cannot beat the area bound never needs its RC, latency, and power stages. */
+#define AREA_PRUNED(bank, areaBound) \
+	(!(bank)->invalid && (bank)->area >= (areaBound))
+
+
+#define CANONICAL_DESIGN_KEY(memoryType) \
+	DesignKey(capacity, blockSize, associativity, numRowSubArray, numColumnSubArray, stackedDieCount, \
+			numActiveSubArrayPerRow, numActiveSubArrayPerColumn, numRowMat, numColumnMat, \
+			numActiveMatPerRow, numActiveMatPerColumn, muxSenseAmp, muxOutputLev1, muxOutputLev2, \
+			numRowPerSet, areaOptimizationLevel, (memoryType))
+
+
+/* Refresh only costs anything for the cells that need it; both work on a Bank and a DesignRecord, */
+/* with memCell the cell the design was built from */
+#define REFRESH_BUSY_RATIO(memCell, design) \
+	(((memCell)->memCellType == eDRAM || (memCell)->memCellType == gcDRAM) ? (design)->refreshLatency / (memCell)->retentionTime : 0)
+
+#define REFRESH_POWER(memCell, design) \
+	(((memCell)->memCellType == eDRAM || (memCell)->memCellType == gcDRAM) ? (design)->refreshDynamicEnergy / (memCell)->retentionTime : 0)
+
+
+/* Works on both a Bank and a DesignRecord */
+#define WITHIN_ALLOWED_DATA_LIMITS(design) \
+	((design)->readLatency <= allowedDataReadLatency && (design)->writeLatency <= allowedDataWriteLatency \
+	&& (design)->readDynamicEnergy <= allowedDataReadDynamicEnergy && (design)->writeDynamicEnergy <= allowedDataWriteDynamicEnergy \
+	&& (design)->leakage <= allowedDataLeakage && (design)->area <= allowedDataArea \
+	&& (design)->readLatency * (design)->readDynamicEnergy <= allowedDataReadEdp \
+	&& (design)->writeLatency * (design)->writeDynamicEnergy <= allowedDataWriteEdp \
+	&& REFRESH_BUSY_RATIO(cell, design) <= allowedDataRefreshBusyRatio && REFRESH_POWER(cell, design) <= allowedDataRefreshPower)
+
+
+#define RECORD_SEEN_DESIGN(key, bank) { \
+	DesignRecord record; \
+	record.readLatency = (bank)->readLatency; \
+	record.writeLatency = (bank)->writeLatency; \
+	record.readDynamicEnergy = (bank)->readDynamicEnergy; \
+	record.writeDynamicEnergy = (bank)->writeDynamicEnergy; \
+	record.leakage = (bank)->leakage; \
+	record.area = (bank)->area; \
+	record.refreshLatency = (bank)->refreshLatency; \
+	record.refreshDynamicEnergy = (bank)->refreshDynamicEnergy; \
+	seenDesigns[(key)] = record; \
+}
+
+
 #define UPDATE_BEST_DATA { \
 	*(tempResult.bank) = *dataBank; \
 	*(tempResult.localWire) = *localWire; \
 	*(tempResult.globalWire) = *globalWire; \
 	for (int i = 0; i < (int)full_exploration; i++) \
-		bestDataResults[i].compareAndUpdate(tempResult); \
+		if (bestDataResults[i].isConfigured()) \
+			bestDataResults[i].compareAndUpdate(tempResult); \
 }
 
 
@@ -156,7 +262,8 @@
 	*(tempResult.localWire) = *localWire; \
 	*(tempResult.globalWire) = *globalWire; \
 	for (int i = 0; i < (int)full_exploration; i++) \
-		bestTagResults[i].compareAndUpdate(tempResult); \
+		if (bestTagResults[i].isConfigured()) \
+			bestTagResults[i].compareAndUpdate(tempResult); \
 }
 
 
@@ -323,13 +430,16 @@
 	(result).limitWriteEdp = allowedDataWriteEdp; \
 	(result).limitArea = allowedDataArea; \
 	(result).limitLeakage = allowedDataLeakage; \
+	(result).limitRefreshBusyRatio = allowedDataRefreshBusyRatio; \
+	(result).limitRefreshPower = allowedDataRefreshPower; \
 }
 
 
 #define OUTPUT_TO_FILE { \
 	if (inputParameter->designTarget == cache) { \
 		for (int i = 0; i < (int)full_exploration; i++) \
-			tempResult.printAsCacheToCsvFile(bestTagResults[i], inputParameter->cacheAccessMode, outputFile); \
+			if (bestTagResults[i].isConfigured()) \
+				tempResult.printAsCacheToCsvFile(bestTagResults[i], inputParameter->cacheAccessMode, outputFile); \
 	} else { \
 		tempResult.printToCsvFile(outputFile); \
 		outputFile << endl; \
@@ -22,6 +22,8 @@
 #include <iomanip>
 #include <math.h>
 #include <cassert>
+#include <unordered_map>
+#include <unistd.h>
 #include "InputParameter.h"
 #include "MemCell.h"
 #include "RowDecoder.h"
@@ -40,6 +42,13 @@
 #include "formula.h"
 #include "macros.h"
 #include "TSV.h"
+#include "DesignKey.h"
+#include "Checkpoint.h"
+#include "Progress.h"
+#include "Hierarchy.h"
+#include "Cosim.h"
+#include "CacheJoin.h"
+#include "Workload.h"
 
 using namespace std;
 
@@ -50,6 +59,11 @@ MemCell *cell;
 Wire *localWire;
 Wire *globalWire;
 MemCell **sweepCells;
+Checkpoint *checkpoint;
+Progress *progress;
+Workload *workload;
+ParetoFrontier *frontier;		/* Set when a hierarchy exploration runs this level */
+CacheJoin *cacheJoin;			/* Set by -CacheLevelOptimization for a cache */
 
 int numRowMat, numColumnMat;
 
@@ -161,6 +175,24 @@ int main(int argc, char *argv[])
 	if (argc == 1) {
 		inputFileName = "nvsim.cfg";
 		cout << "Default configuration file (nvsim.cfg) is loaded" << endl;
+	} else if (argc == 3 && string(argv[1]) == "--hierarchy") {
+		Hierarchy hierarchy;
+		hierarchy.ReadFromFile(argv[2]);
+		return hierarchy.Explore(argv[0]);
+	} else if (argc == 3 && string(argv[1]) == "--cosim") {
+		Cosim cosim;
+		cosim.ReadFromFile(argv[2]);
+		return cosim.Explore(argv[0]);
+	} else if (argc == 4 && string(argv[1]) == "--pareto") {
+		/* One level of a hierarchy exploration or co-optimization, its Pareto frontier goes to argv[2] */
+		frontier = new ParetoFrontier();
+		inputFileName = argv[3];
+		cout << "User-defined configuration file (" << inputFileName << ") is loaded" << endl;
+	} else if (argc == 3 && string(argv[1]) == "--resume") {
+		checkpoint = new Checkpoint();
+		checkpoint->Load(argv[2]);
+		inputFileName = checkpoint->configFile;
+		cout << "Resuming configuration file (" << inputFileName << ") from checkpoint " << argv[2] << endl;
 	} else {
 		inputFileName = argv[1];
 		cout << "User-defined configuration file (" << inputFileName << ") is loaded" << endl;
@@ -171,6 +203,50 @@ int main(int argc, char *argv[])
 	RESTORE_SEARCH_SIZE;
 	inputParameter->ReadInputParameterFromFile(inputFileName);
 
+	if (!checkpoint && !inputParameter->checkpointFile.empty()) {
+		checkpoint = new Checkpoint();
+		checkpoint->fileName = inputParameter->checkpointFile;
+		checkpoint->configFile = inputFileName;
+		checkpoint->inputHash = checkpoint->HashInputs();
+	} else if (checkpoint && checkpoint->inputHash != checkpoint->HashInputs()) {
+		cout << "[ERROR] The configuration, cell, or workload files changed since checkpoint " << argv[2]
+				<< " was written, resuming would mix the results of two explorations" << endl;
+		exit(-1);
+	}
+	if (checkpoint)
+		checkpoint->interval = inputParameter->checkpointInterval;
+
+	if (!inputParameter->workloadStatsFile.empty()) {
+		workload = new Workload();
+		workload->ReadStatsFile(inputParameter->workloadStatsFile, inputParameter->workloadController);
+	} else if (inputParameter->optimizationTarget == workload_edp_optimized) {
+		cout << "[ERROR] -OptimizationTarget: WorkloadEDP needs the gem5 statistics in -WorkloadStats" << endl;
+		exit(-1);
+	}
+	if (inputParameter->optimizationTarget == sustained_bandwidth_optimized && inputParameter->pipelineDepth <= 0) {
+		cout << "[ERROR] -OptimizationTarget: SustainedBandwidth needs the reads in flight in -PipelineDepth" << endl;
+		exit(-1);
+	}
+
+	if (inputParameter->cacheLevelOptimization) {
+		if (inputParameter->designTarget == cache)
+			cacheJoin = new CacheJoin();
+		else
+			cout << "[WARNING] -CacheLevelOptimization is ignored for non-cache designs" << endl;
+	}
+	/* A hierarchy level builds its frontier on the tag frontier of the cache-level join */
+	if (frontier && inputParameter->designTarget == cache) {
+		if (!cacheJoin)
+			cacheJoin = new CacheJoin();
+		cacheJoin->levelTags = true;
+	}
+
+	if (inputParameter->progressInterval > 0) {
+		progress = new Progress();
+		progress->interval = inputParameter->progressInterval;
+		progress->Open(inputParameter->progressFile);
+	}
+
     //tsvVerif(inputParameter);
 
 	tech = new Technology();
@@ -198,7 +274,17 @@ int main(int argc, char *argv[])
 		outputFileName = temp.str();*/
         int extIdx = inputFileName.find_last_of("."); 
         outputFileName = inputFileName.substr(0, extIdx) + ".csv";
-		outputFile.open(outputFileName.c_str(), ofstream::out | ofstream::trunc);
+		if (checkpoint && checkpoint->resuming) {
+			/* Drop whatever was written after the checkpoint and append from there */
+			if (truncate(outputFileName.c_str(), checkpoint->outputOffset)) {
+				cout << "Could not rewind file " << outputFileName << "!" << endl;
+				exit(-1);
+			}
+			outputFile.open(outputFileName.c_str(), ofstream::in | ofstream::out);
+			outputFile.seekp(0, ofstream::end);
+		} else {
+			outputFile.open(outputFileName.c_str(), ofstream::out | ofstream::trunc);
+		}
         if (!outputFile.is_open()) {
             cout << "Could not open file " << outputFileName << "!" << endl;
             exit(-1);
@@ -213,6 +299,10 @@ int main(int argc, char *argv[])
 
     int failures = 0;
     long long totalSolutions = 0;
+    if (checkpoint && checkpoint->resuming) {
+        failures = checkpoint->failures;
+        totalSolutions = checkpoint->totalSolutions;
+    }
     for (int cellIdx = 0; cellIdx < numCellTypes; cellIdx++) {
         long long solutions = 0;
         sweepCells[cellIdx] = new MemCell();
@@ -229,19 +319,53 @@ int main(int argc, char *argv[])
             initializeTechnology(devtech, inputParameter->processNode, EDRAM);
         }
 
-        if (cellIdx == 0) // Print once only
+        if (cellIdx == 0) { // Print once only
             inputParameter->PrintInputParameter();
+            if (workload)
+                workload->PrintProperty();
+        }
 
         cout << "Using cell file: " << inputParameter->fileMemCell[cellIdx] << endl;
     
         bestDataResults[cellIdx] = new Result[(int)full_exploration];
         bestTagResults[cellIdx] = new Result[(int)full_exploration];
 
-        /* Find the best solutions, pruned solutions, or all solutions for this cell type. */
-        if (nvsim(outputFile, inputFileName, solutions, bestDataResults[cellIdx], bestTagResults[cellIdx])) {
-            failures++;
+        if (checkpoint && checkpoint->resuming && cellIdx < checkpoint->cellIdx) {
+            /* This cell was finished before the checkpoint, rebuild its best results only */
+            localWire = new Wire();
+            globalWire = new Wire();
+            checkpoint->RestoreCell(cellIdx, bestDataResults[cellIdx], bestTagResults[cellIdx]);
+            for (int i = 0; i < (int)full_exploration; i++) {
+                bestDataResults[cellIdx][i].optimizationTarget = (OptimizationTarget)i;
+                bestDataResults[cellIdx][i].cellTech = cell;
+                bestTagResults[cellIdx][i].optimizationTarget = (OptimizationTarget)i;
+                bestTagResults[cellIdx][i].cellTech = cell;
+                if (inputParameter->designTarget == cache)
+                    bestDataResults[cellIdx][i].quantizationTag = &bestTagResults[cellIdx][i];
+            }
+            delete localWire;
+            delete globalWire;
         } else {
-            totalSolutions += solutions;
+            if (checkpoint)
+                checkpoint->cellIdx = cellIdx;
+            if (frontier)
+                frontier->cellFile = inputParameter->fileMemCell[cellIdx];
+            if (progress) {
+                progress->cellIdx = cellIdx;
+                progress->numCells = inputParameter->fileMemCell.size();
+            }
+            /* Find the best solutions, pruned solutions, or all solutions for this cell type. */
+            if (nvsim(outputFile, inputFileName, solutions, bestDataResults[cellIdx], bestTagResults[cellIdx])) {
+                failures++;
+            } else {
+                totalSolutions += solutions;
+            }
+            if (checkpoint) {
+                checkpoint->resuming = false;
+                checkpoint->failures = failures;
+                checkpoint->totalSolutions = totalSolutions;
+                checkpoint->StoreCell(cellIdx, bestDataResults[cellIdx], bestTagResults[cellIdx]);
+            }
         }
 
         if (cell->memCellType == eDRAM) {
@@ -259,6 +383,8 @@ int main(int argc, char *argv[])
         /* Pick the best of the best for each optimization target. */
         for (int cellIdx = 1; cellIdx < numCellTypes; cellIdx++) {
             for (int tgtIdx = 0; tgtIdx < (int)full_exploration; tgtIdx++) {
+                if (!bestDataResults[cellIdx][tgtIdx].isConfigured())
+                    continue;
                 bool updated = bestDataResults[0][tgtIdx].compareAndUpdate(bestDataResults[cellIdx][tgtIdx]);
                 
                 if (updated && !inputParameter->allowDifferentTagTech) {
@@ -287,14 +413,33 @@ int main(int argc, char *argv[])
             cell = bestDataResults[0][inputParameter->optimizationTarget].cellTech;
             //cell->PrintCell();
 
+			/* A target with a cache-level counterpart reports the jointly optimized pair */
+			Result *dataResult = &bestDataResults[0][inputParameter->optimizationTarget];
+			Result *tagResult = &bestTagResults[0][inputParameter->optimizationTarget];
+			CacheObjective objective = CacheJoin::getObjective(inputParameter->optimizationTarget);
+			if (cacheJoin && objective != num_cache_objectives && cacheJoin->getData(objective)->bank->readLatency < invalid_value) {
+				dataResult = cacheJoin->getData(objective);
+				tagResult = cacheJoin->getTag(objective);
+				cell = dataResult->cellTech;
+			}
+
 			if (inputParameter->designTarget == cache)
-				bestDataResults[0][inputParameter->optimizationTarget].printAsCache(bestTagResults[0][inputParameter->optimizationTarget], inputParameter->cacheAccessMode);
+				dataResult->printAsCache(*tagResult, inputParameter->cacheAccessMode);
 			else
-				bestDataResults[0][inputParameter->optimizationTarget].print();
+				dataResult->print();
+
+			if (inputParameter->refreshSchedulePolicy != simultaneous_refresh)
+				dataResult->printRefreshScheduleToFile(inputParameter->designTarget == cache ? tagResult : NULL,
+						inputParameter->refreshScheduleFile);
+			if (inputParameter->nucaSlices > 0)
+				dataResult->printNucaLatencyToFile(inputParameter->designTarget == cache ? tagResult : NULL,
+						inputParameter->nucaLatencyFile);
         } else if (totalSolutions > 0) {
             //cell->PrintCell();
 
             for (int tgtIdx = 0; tgtIdx < (int)full_exploration; tgtIdx++) {
+                if (!bestDataResults[0][tgtIdx].isConfigured())
+                    continue;
                 cell = bestDataResults[0][tgtIdx].cellTech;
 
                 if (inputParameter->designTarget == cache)
@@ -305,6 +450,8 @@ int main(int argc, char *argv[])
 		} else {
 			cout << "No valid solutions." << endl;
 		}
+		if (cacheJoin && totalSolutions > 0)
+			cacheJoin->Print(bestDataResults[0], bestTagResults[0]);
 		cout << endl << "Finished!" << endl;
 	} else {
 		cout << endl << outputFileName << " generated successfully!" << endl;
@@ -318,6 +465,13 @@ int main(int argc, char *argv[])
 		}
 	}
 
+	if (frontier)
+		frontier->WriteToFile(argv[2]);
+
+	/* The exploration is complete, a stale checkpoint would only repeat it */
+	if (checkpoint)
+		remove(checkpoint->fileName.c_str());
+
 	return 0;
 }
 
@@ -396,6 +550,20 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 	int associativity;
 
     long long numDesigns = 0;
+    long long numPrunedDesigns = 0;
+    long long numDuplicateDesigns = 0;
+
+	/* The constrained pass walks the same design space again; remember what the first pass already saw */
+	unordered_map<DesignKey, DesignRecord, DesignKeyHash> seenDesigns;
+
+	/* Partial evaluation only pays off when area is the sole ranked metric; the unconstrained pass of a */
+	/* constrained search still needs every target's optimum to derive the allowed values, and the */
+	/* cache-level join and the Pareto frontier need every design whatever its area. A pruned design */
+	/* still counts as a solution, so DRAM cells, whose retention check needs the later stages, are */
+	/* always evaluated in full. */
+	bool pruneByArea = inputParameter->partialEvaluation && inputParameter->optimizationTarget == area_optimized
+			&& !inputParameter->printAllOptimals && !cacheJoin && !frontier
+			&& cell->memCellType != eDRAM && cell->memCellType != gcDRAM;
 
 	/* for cache data array, memory array */
 	//Result *bestDataResults = new Result[(int)full_exploration];	/* full_exploration is always set as the last element in the enum, so if full_exploration is 8, what we want here is a 0-7 array, which is correct */
@@ -418,8 +586,31 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 
     partitionGranularity = inputParameter->partitionGranularity;
 
+	/* Pick up where an interrupted run left off */
+	bool resuming = checkpoint && checkpoint->resuming;
+	SearchPhase resumePhase = tag_search;
+	long long searchPosition = 0, resumePosition = 0;
+	if (resuming) {
+		checkpoint->RestoreCell(checkpoint->cellIdx, bestDataResults, bestTagResults);
+		resumePhase = checkpoint->phase;
+		numSolution = checkpoint->numSolution;
+		numDesigns = checkpoint->numDesigns;
+		numPrunedDesigns = checkpoint->numPrunedDesigns;
+		numDuplicateDesigns = checkpoint->numDuplicateDesigns;
+		tech->SetTSVState(checkpoint->tsvState);
+	}
+	/* A resumed run has not seen the designs before the checkpoint */
+	bool seenDesignsComplete = (resumePhase == tag_search);
+
+	/* The tag frontier of a cell is only complete if its tag search runs in this process */
+	if (cacheJoin) {
+		cacheJoin->ClearTags();
+		if (resumePhase != tag_search)
+			cout << "[WARNING] The cache-level optima skip this cell, its tag search finished before the checkpoint" << endl;
+	}
+
 	/* search tag first */
-	if (inputParameter->designTarget == cache) {
+	if (inputParameter->designTarget == cache && resumePhase == tag_search) {
 		/* need to design the tag array */
 		REDUCE_SEARCH_SIZE;
 		/* calculate the tag configuration */
@@ -427,8 +618,12 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 		int numIndexBit = (int)(log2(numDataSet) + 0.1);
 		int numOffsetBit = (int)(log2(inputParameter->wordWidth / 8) + 0.1);
 		INITIAL_BASIC_WIRE;
+		RESUME_SEARCH_PHASE(tag_search);
+		BEGIN_PROGRESS_PHASE(tag_search);
 		/* Simulate tag */
 		BIGFOR {
+			CHECKPOINT_OR_SKIP(tag_search);
+			REPORT_PROGRESS(bestTagResults);
             tech->SetLayerCount(inputParameter, stackedDieCount);
 			blockSize = TOTAL_ADDRESS_BIT - numIndexBit - numOffsetBit;
 			blockSize += 2;		/* add dirty bits and valid bits */
@@ -442,13 +637,22 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 			}
 			capacity = (long long)inputParameter->capacity * 8 / inputParameter->wordWidth * blockSize;
 			associativity = inputParameter->associativity;
-			CALCULATE(tagBank, MemoryType::tag);
+			CALCULATE_AREA(tagBank, MemoryType::tag);
             numDesigns++;
+			if (pruneByArea && AREA_PRUNED(tagBank, bestTagResults[area_optimized].bank->area)) {
+				numPrunedDesigns++;
+				numSolution++;
+				delete tagBank;
+				continue;
+			}
+			CALCULATE_LATENCY_AND_POWER(tagBank);
 			if (!tagBank->invalid) {
 				Result tempResult;
 				VERIFY_TAG_CAPACITY;
 				numSolution++;
 				UPDATE_BEST_TAG;
+				if (cacheJoin)
+					cacheJoin->InsertTag(tempResult);
 			}
 			delete tagBank;
 		}
@@ -462,6 +666,8 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 						(WireRepeaterType)localWireRepeaterType, inputParameter->temperature,
 						(bool)isLocalWireLowSwing);
 				for (int i = 0; i < (int)full_exploration; i++) {
+					if (!bestTagResults[i].isConfigured())
+						continue;
 					LOAD_GLOBAL_WIRE(bestTagResults[i]);
 					TRY_AND_UPDATE(bestTagResults[i], MemoryType::tag);
 				}
@@ -472,10 +678,19 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 						(WireRepeaterType)globalWireRepeaterType, inputParameter->temperature,
 						(bool)isGlobalWireLowSwing);
 				for (int i = 0; i < (int)full_exploration; i++) {
+					if (!bestTagResults[i].isConfigured())
+						continue;
 					LOAD_LOCAL_WIRE(bestTagResults[i]);
 					TRY_AND_UPDATE(bestTagResults[i], MemoryType::tag);
 				}
 			}
+			/* The refined wires can beat every design of the search */
+			if (cacheJoin) {
+				for (int i = 0; i < (int)full_exploration; i++)
+					if (bestTagResults[i].bank->readLatency < invalid_value)
+						cacheJoin->InsertTag(bestTagResults[i]);
+				cacheJoin->FinishTags();
+			}
 		}
 
 		if (numSolution == 0) {
@@ -488,6 +703,7 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 		} else {
 			numSolution = 0;
             numDesigns = 0;
+            numPrunedDesigns = 0;
 			RESTORE_SEARCH_SIZE;
 			inputParameter->ReadInputParameterFromFile(inputFileName);	/* just for restoring the search space */
 			applyConstraint();
@@ -523,60 +739,107 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 		associativity = 1;
 	}
 
-	INITIAL_BASIC_WIRE;
-	BIGFOR {
-		if (blockSize / (numActiveSubArrayPerRow * numActiveSubArrayPerColumn * numActiveMatPerRow * numActiveMatPerColumn) == 0) {
-			/* To aggressive partitioning */
-			continue;
-		}
-        //if (capacity / (numRowSubArray * numColumnSubArray * numRowMat * numColumnMat) < 32*32) {
-        //    // Require at least 32x32 subarrays.
-        //    continue;
-        //}
-		CALCULATE(dataBank, MemoryType::data);
-        numDesigns++;
-		if (!dataBank->invalid) {
-			Result tempResult;
-			VERIFY_DATA_CAPACITY;
-			numSolution++;
-			UPDATE_BEST_DATA;
-			// tempResult.printToCsvFile(outputFile);
-//			tempResult.printAsCacheToFile(inputParameter->cacheAccessMode, "tempResult"+ std::to_string(numSolution)+".nsd");
-			if (inputParameter->optimizationTarget == full_exploration && !inputParameter->isPruningEnabled) {
-				OUTPUT_TO_FILE;
-			}
-		}
-		delete dataBank; 
+	/* Cycle ranking of a cache counts the whole access, with the tag array each target settled on */
+	if (inputParameter->designTarget == cache)
+		for (int i = 0; i < (int)full_exploration; i++)
+			bestDataResults[i].quantizationTag = &bestTagResults[i];
+
+	/* A hierarchy level pairs every data design with every tag it could trade against, a RAM has none */
+	vector<const Bank *> frontierTags;
+	if (frontier && inputParameter->designTarget == cache) {
+		for (int i = 0; i < (int)cacheJoin->getTags().size(); i++)
+			frontierTags.push_back(cacheJoin->getTags()[i]->bank);
+	} else {
+		frontierTags.push_back(NULL);
 	}
 
-	if (numSolution > 0) {
-		Bank * trialBank;
-		Result tempResult;
-		/* refine local wire type */
-		REFINE_LOCAL_WIRE_FORLOOP {
-			localWire->Initialize(inputParameter->processNode, (WireType)localWireType,
-					(WireRepeaterType)localWireRepeaterType, inputParameter->temperature,
-					(bool)isLocalWireLowSwing);
-			for (int i = 0; i < (int)full_exploration; i++) {
-				LOAD_GLOBAL_WIRE(bestDataResults[i]);
-				TRY_AND_UPDATE(bestDataResults[i], MemoryType::data);
+	/* Under design constraints only the designs of the constrained pass are paired */
+	bool joinConstrained = inputParameter->isConstraintApplied && inputParameter->optimizationTarget != full_exploration;
+
+	/* A run resumed in the constrained pass already has its unconstrained optima folded into the limits */
+	if (resumePhase != constrained_search) {
+		INITIAL_BASIC_WIRE;
+		RESUME_SEARCH_PHASE(data_search);
+		BEGIN_PROGRESS_PHASE(data_search);
+		BIGFOR {
+			CHECKPOINT_OR_SKIP(data_search);
+			REPORT_PROGRESS(bestDataResults);
+			if (blockSize / (numActiveSubArrayPerRow * numActiveSubArrayPerColumn * numActiveMatPerRow * numActiveMatPerColumn) == 0) {
+				/* To aggressive partitioning */
+				continue;
 			}
-			if (inputParameter->optimizationTarget == full_exploration && !inputParameter->isPruningEnabled) {
-				OUTPUT_TO_FILE;
+	        //if (capacity / (numRowSubArray * numColumnSubArray * numRowMat * numColumnMat) < 32*32) {
+	        //    // Require at least 32x32 subarrays.
+	        //    continue;
+	        //}
+			CALCULATE_AREA(dataBank, MemoryType::data);
+	        numDesigns++;
+			if (pruneByArea && !inputParameter->isConstraintApplied
+					&& AREA_PRUNED(dataBank, bestDataResults[area_optimized].bank->area)) {
+				numPrunedDesigns++;
+				numSolution++;
+				delete dataBank;
+				continue;
 			}
+			CALCULATE_LATENCY_AND_POWER(dataBank);
+			if (!dataBank->invalid) {
+				Result tempResult;
+				VERIFY_DATA_CAPACITY;
+				numSolution++;
+				UPDATE_BEST_DATA;
+				if (frontier)
+					for (int i = 0; i < (int)frontierTags.size(); i++)
+						frontier->Insert(dataBank, frontierTags[i]);
+				if (cacheJoin && !joinConstrained)
+					cacheJoin->Join(tempResult);
+				if (inputParameter->isConstraintApplied && inputParameter->optimizationTarget != full_exploration)
+						RECORD_SEEN_DESIGN(CANONICAL_DESIGN_KEY(MemoryType::data), dataBank);
+				// tempResult.printToCsvFile(outputFile);
+	//			tempResult.printAsCacheToFile(inputParameter->cacheAccessMode, "tempResult"+ std::to_string(numSolution)+".nsd");
+				if (inputParameter->optimizationTarget == full_exploration && !inputParameter->isPruningEnabled) {
+					OUTPUT_TO_FILE;
+				}
+			}
+			delete dataBank; 
 		}
-		/* refine global wire type */
-		REFINE_GLOBAL_WIRE_FORLOOP {
-			globalWire->Initialize(inputParameter->processNode, (WireType)globalWireType,
-					(WireRepeaterType)globalWireRepeaterType, inputParameter->temperature,
-					(bool)isGlobalWireLowSwing);
-			for (int i = 0; i < (int)full_exploration; i++) {
-				LOAD_LOCAL_WIRE(bestDataResults[i]);
-				TRY_AND_UPDATE(bestDataResults[i], MemoryType::data);
+
+		if (numSolution > 0) {
+			Bank * trialBank;
+			Result tempResult;
+			/* refine local wire type */
+			REFINE_LOCAL_WIRE_FORLOOP {
+				localWire->Initialize(inputParameter->processNode, (WireType)localWireType,
+						(WireRepeaterType)localWireRepeaterType, inputParameter->temperature,
+						(bool)isLocalWireLowSwing);
+				for (int i = 0; i < (int)full_exploration; i++) {
+					if (!bestDataResults[i].isConfigured())
+						continue;
+					LOAD_GLOBAL_WIRE(bestDataResults[i]);
+					TRY_AND_UPDATE(bestDataResults[i], MemoryType::data);
+				}
+				if (inputParameter->optimizationTarget == full_exploration && !inputParameter->isPruningEnabled) {
+					OUTPUT_TO_FILE;
+				}
 			}
-			if (inputParameter->optimizationTarget == full_exploration && !inputParameter->isPruningEnabled) {
-				OUTPUT_TO_FILE;
+			/* refine global wire type */
+			REFINE_GLOBAL_WIRE_FORLOOP {
+				globalWire->Initialize(inputParameter->processNode, (WireType)globalWireType,
+						(WireRepeaterType)globalWireRepeaterType, inputParameter->temperature,
+						(bool)isGlobalWireLowSwing);
+				for (int i = 0; i < (int)full_exploration; i++) {
+					if (!bestDataResults[i].isConfigured())
+						continue;
+					LOAD_LOCAL_WIRE(bestDataResults[i]);
+					TRY_AND_UPDATE(bestDataResults[i], MemoryType::data);
+				}
+				if (inputParameter->optimizationTarget == full_exploration && !inputParameter->isPruningEnabled) {
+					OUTPUT_TO_FILE;
+				}
 			}
+			if (cacheJoin && !joinConstrained)
+				for (int i = 0; i < (int)full_exploration; i++)
+					if (bestDataResults[i].bank->readLatency < invalid_value)
+						cacheJoin->Join(bestDataResults[i]);
 		}
 	}
 
@@ -600,6 +863,8 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 		for (int i = 0; i < (int)full_exploration; i++)
 			for (int j = 0; j < (int)full_exploration; j++)
 				for (int k = 0; k < 3; k++) {
+					if (!bestDataResults[i].isConfigured() || !bestDataResults[j].isConfigured())
+						continue;
 					pruningResults[i][j][k]->optimizationTarget = (OptimizationTarget)i;
 					*(pruningResults[i][j][k]->localWire) = *(bestDataResults[i].localWire);
 					*(pruningResults[i][j][k]->globalWire) = *(bestDataResults[i].globalWire);
@@ -634,6 +899,18 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 					case leakage_optimized:
 						pruningResults[i][j][k]->limitLeakage = bestDataResults[j].bank->leakage * (1 + (k + 1.0) / 10);
 						break;
+					case refresh_busy_optimized:
+						pruningResults[i][j][k]->limitRefreshBusyRatio = bestDataResults[j].getRefreshBusyRatio() * (1 + (k + 1.0) / 10);
+						break;
+					case refresh_power_optimized:
+						pruningResults[i][j][k]->limitRefreshPower = bestDataResults[j].getRefreshPower() * (1 + (k + 1.0) / 10);
+						break;
+					case workload_edp_optimized:
+						/* no constraint on the workload */
+						break;
+					case sustained_bandwidth_optimized:
+						/* no constraint on the pipeline */
+						break;
 					default:
 						/* nothing should happen here */
 						cout << "Warning: should not happen" << endl;
@@ -641,6 +918,8 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 				}
 
 		for (int i = 0; i < (int)full_exploration; i++) {
+			if (!bestDataResults[i].isConfigured())
+				continue;
 			bestDataResults[i].printAsCacheToCsvFile(bestTagResults[i], inputParameter->cacheAccessMode, outputFile);
 			//bestDataResults[i].printToCsvFile(outputFile);
 		}
@@ -661,37 +940,84 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 
 	/* If design constraint is applied */
 	if (inputParameter->optimizationTarget != full_exploration && inputParameter->isConstraintApplied) {
-		double allowedDataReadLatency = bestDataResults[read_latency_optimized].bank->readLatency * (inputParameter->readLatencyConstraint + 1);
-		double allowedDataWriteLatency = bestDataResults[write_latency_optimized].bank->writeLatency * (inputParameter->writeLatencyConstraint + 1);
-		double allowedDataReadDynamicEnergy = bestDataResults[read_energy_optimized].bank->readDynamicEnergy * (inputParameter->readDynamicEnergyConstraint + 1);
-		double allowedDataWriteDynamicEnergy = bestDataResults[write_energy_optimized].bank->writeDynamicEnergy * (inputParameter->writeDynamicEnergyConstraint + 1);
-		double allowedDataLeakage = bestDataResults[leakage_optimized].bank->leakage * (inputParameter->leakageConstraint + 1);
-		double allowedDataArea = bestDataResults[area_optimized].bank->area * (inputParameter->areaConstraint + 1);
-		double allowedDataReadEdp = bestDataResults[read_edp_optimized].bank->readLatency
-				* bestDataResults[read_edp_optimized].bank->readDynamicEnergy * (inputParameter->readEdpConstraint + 1);
-		double allowedDataWriteEdp = bestDataResults[write_edp_optimized].bank->writeLatency
-				* bestDataResults[write_edp_optimized].bank->writeDynamicEnergy * (inputParameter->writeEdpConstraint + 1);
-		for (int i = 0; i < (int)full_exploration; i++) {
-			APPLY_LIMIT(bestDataResults[i]);
+		double allowedDataReadLatency, allowedDataWriteLatency, allowedDataReadDynamicEnergy, allowedDataWriteDynamicEnergy;
+		double allowedDataLeakage, allowedDataArea, allowedDataReadEdp, allowedDataWriteEdp;
+		double allowedDataRefreshBusyRatio, allowedDataRefreshPower;
+		if (resumePhase == constrained_search) {
+			/* The limits were applied before the checkpoint was taken */
+			allowedDataReadLatency = bestDataResults[0].limitReadLatency;
+			allowedDataWriteLatency = bestDataResults[0].limitWriteLatency;
+			allowedDataReadDynamicEnergy = bestDataResults[0].limitReadDynamicEnergy;
+			allowedDataWriteDynamicEnergy = bestDataResults[0].limitWriteDynamicEnergy;
+			allowedDataLeakage = bestDataResults[0].limitLeakage;
+			allowedDataArea = bestDataResults[0].limitArea;
+			allowedDataReadEdp = bestDataResults[0].limitReadEdp;
+			allowedDataWriteEdp = bestDataResults[0].limitWriteEdp;
+			allowedDataRefreshBusyRatio = bestDataResults[0].limitRefreshBusyRatio;
+			allowedDataRefreshPower = bestDataResults[0].limitRefreshPower;
+		} else {
+			allowedDataReadLatency = bestDataResults[read_latency_optimized].bank->readLatency * (inputParameter->readLatencyConstraint + 1);
+			allowedDataWriteLatency = bestDataResults[write_latency_optimized].bank->writeLatency * (inputParameter->writeLatencyConstraint + 1);
+			allowedDataReadDynamicEnergy = bestDataResults[read_energy_optimized].bank->readDynamicEnergy * (inputParameter->readDynamicEnergyConstraint + 1);
+			allowedDataWriteDynamicEnergy = bestDataResults[write_energy_optimized].bank->writeDynamicEnergy * (inputParameter->writeDynamicEnergyConstraint + 1);
+			allowedDataLeakage = bestDataResults[leakage_optimized].bank->leakage * (inputParameter->leakageConstraint + 1);
+			allowedDataArea = bestDataResults[area_optimized].bank->area * (inputParameter->areaConstraint + 1);
+			allowedDataReadEdp = bestDataResults[read_edp_optimized].bank->readLatency
+					* bestDataResults[read_edp_optimized].bank->readDynamicEnergy * (inputParameter->readEdpConstraint + 1);
+			allowedDataWriteEdp = bestDataResults[write_edp_optimized].bank->writeLatency
+					* bestDataResults[write_edp_optimized].bank->writeDynamicEnergy * (inputParameter->writeEdpConstraint + 1);
+			allowedDataRefreshBusyRatio = bestDataResults[refresh_busy_optimized].getRefreshBusyRatio() * (inputParameter->refreshBusyRatioConstraint + 1);
+			allowedDataRefreshPower = bestDataResults[refresh_power_optimized].getRefreshPower() * (inputParameter->refreshPowerConstraint + 1);
+			for (int i = 0; i < (int)full_exploration; i++) {
+				APPLY_LIMIT(bestDataResults[i]);
+			}
+			numSolution = 0;
 		}
 
-		numSolution = 0;
 		INITIAL_BASIC_WIRE;
+		RESUME_SEARCH_PHASE(constrained_search);
+		BEGIN_PROGRESS_PHASE(constrained_search);
 		BIGFOR {
+			CHECKPOINT_OR_SKIP(constrained_search);
+			REPORT_PROGRESS(bestDataResults);
 			if (blockSize / (numActiveSubArrayPerRow * numActiveSubArrayPerColumn * numActiveMatPerRow * numActiveMatPerColumn) == 0) {
 				/* To aggressive partitioning */
 				continue;
 			}
-			CALCULATE(dataBank, MemoryType::data);
             numDesigns++;
-			if (!dataBank->invalid && dataBank->readLatency <= allowedDataReadLatency && dataBank->writeLatency <= allowedDataWriteLatency
-					&& dataBank->readDynamicEnergy <= allowedDataReadDynamicEnergy && dataBank->writeDynamicEnergy <= allowedDataWriteDynamicEnergy
-					&& dataBank->leakage <= allowedDataLeakage && dataBank->area <= allowedDataArea
-					&& dataBank->readLatency * dataBank->readDynamicEnergy <= allowedDataReadEdp && dataBank->writeLatency * dataBank->writeDynamicEnergy <= allowedDataWriteEdp) {
+			/* Designs missing from the first pass were invalid there, so only known survivors are evaluated again */
+			if (seenDesignsComplete) {
+				unordered_map<DesignKey, DesignRecord, DesignKeyHash>::const_iterator seen
+						= seenDesigns.find(CANONICAL_DESIGN_KEY(MemoryType::data));
+				if (seen == seenDesigns.end() || !WITHIN_ALLOWED_DATA_LIMITS(&seen->second)) {
+					numDuplicateDesigns++;
+					continue;
+				}
+			}
+			CALCULATE_AREA(dataBank, MemoryType::data);
+			if (inputParameter->partialEvaluation && !dataBank->invalid && dataBank->area > allowedDataArea) {
+				numPrunedDesigns++;
+				delete dataBank;
+				continue;
+			}
+			/* The first pass already found the design valid and within the limits */
+			if (pruneByArea && seenDesignsComplete && AREA_PRUNED(dataBank, bestDataResults[area_optimized].bank->area)) {
+				numPrunedDesigns++;
+				numSolution++;
+				delete dataBank;
+				continue;
+			}
+			CALCULATE_LATENCY_AND_POWER(dataBank);
+			if (!dataBank->invalid && WITHIN_ALLOWED_DATA_LIMITS(dataBank)) {
 				Result tempResult;
 				VERIFY_DATA_CAPACITY;
 				numSolution++;
 				UPDATE_BEST_DATA;
+				if (frontier)
+					for (int i = 0; i < (int)frontierTags.size(); i++)
+						frontier->Insert(dataBank, frontierTags[i]);
+				if (cacheJoin)
+					cacheJoin->Join(tempResult);
 				tempResult.printToCsvFile(outputFile);
 			}
 			delete dataBank;
@@ -699,6 +1025,10 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 	}
 
     cout << "numSolutions = " << numSolution << " / numDesigns = " << numDesigns << endl;
+	if (numDuplicateDesigns > 0)
+		cout << "[Info] Skipped " << numDuplicateDesigns << " duplicate designs already evaluated in an earlier pass" << endl;
+	if (inputParameter->partialEvaluation)
+		cout << "[Info] Partial evaluation skipped the RC, latency, and power stages of " << numPrunedDesigns << " designs" << endl;
 	globalWire->PrintProperty();
 
 	if (localWire) delete localWire;
@@ -99,6 +99,20 @@ enum RoutingMode
 	non_h_tree
 };
 
+enum RefreshSchedulePolicy
+{
+	simultaneous_refresh,		/* Every bank starts its refresh window at cycle 0 */
+	total_fill_refresh,			/* Starts spread evenly over the refresh period */
+	back_to_back_refresh,		/* Each bank starts when the previous one finishes */
+	partial_overlap_refresh		/* Each bank starts halfway through the previous one */
+};
+
+enum HierarchyObjective
+{
+	amat_objective,				/* Average memory access time */
+	energy_objective			/* Dynamic and leakage energy per access */
+};
+
 enum WriteScheme
 {
 	set_before_reset,
@@ -128,7 +142,11 @@ enum OptimizationTarget
 	write_bandwidth_optimized = 7,
 	leakage_optimized = 8,
 	area_optimized = 9,
-	full_exploration = 10
+	refresh_busy_optimized = 10,		/* Fraction of the retention period the bank is busy refreshing */
+	refresh_power_optimized = 11,
+	workload_edp_optimized = 12,		/* Energy times stall time of the -WorkloadStats traffic */
+	sustained_bandwidth_optimized = 13,	/* Read bandwidth with -PipelineDepth accesses in flight */
+	full_exploration = 14
 };
 
 enum CacheAccessMode
@@ -140,6 +158,18 @@ enum CacheAccessMode
 	fast_access_mode		/* data and tag access happen in parallel */
 };
 
+enum PipelineStage
+{
+	predecode_stage,		/* Subarray address predecoders */
+	decode_stage,			/* Mat row and column decoders */
+	bitline_stage,			/* Bitline, bitline mux, sense amplifier, and precharge; holds the mat */
+	mux_stage,				/* Sense amplifier output muxes */
+	compare_stage,			/* Tag comparators */
+	routing_stage,			/* H-tree or bus, one way, or its slowest latched segment */
+	tsv_stage,				/* Die-to-die TSVs, one way */
+	num_pipeline_stages
+};
+
 enum TSV_type 
 {
     Fine = 0,        // ITRS high density